@@ -0,0 +1,604 @@
+/**
+* \file   bench.c
+* \author Trung Tin Nguyen (1120436), and Dung Anh Huynh Pham (764527)
+* \date   17.10.2026
+*
+* \brief Benchmark mode of the firmware: cycles of every phase of the SHA-1 Packet Object
+*
+* \copyright Copyright 2023
+* Department of electrical engineering and information technology, Hochschule Darmstadt - University of applied sciences (h_da). All Rights Reserved.
+* Permission to use, copy, modify, and distribute this software and its documentation for educational, and research purposes in the context of non-commercial
+* (unless permitted by h_da) and official h_da projects, is hereby granted for enrolled students of h_da, provided that the above copyright notice,
+* this paragraph and the following paragraph appear in all copies, modifications, and distributions.
+*
+* Contact Prof.Dr. C. Jakob, christian.jakob@h-da.de, Birkenweg 8 64295 Darmstadt - GERMANY for commercial requests.
+*
+* \warning This software is a PROTOTYPE version and is not designed or intended for use in production, especially not for safety-critical applications!
+* The user represents and warrants that it will NOT use or redistribute the Software for such purposes.
+* This prototype is for research purposes only. This software is provided "AS IS," without a warranty of any kind.
+*/
+
+
+/*****************************************************************************/
+/* Include files                                                             */
+/*****************************************************************************/
+#include <stdlib.h>	//for the usage of malloc
+#include <string.h>	//for memcpy()
+
+#include "platform.h"
+#include "bench.h"
+#include "timer.h"
+#include "msg.h"
+#include "sha1.h"
+#include "sha1_config.h"
+
+
+/*****************************************************************************/
+/* Local type definitions ('typedef')                                        */
+/*****************************************************************************/
+
+/**
+ * \brief Cycles of the phases of one run.
+ */
+struct sBENCH_result {
+  uint32_t	m_length;				/**< in bytes */
+  uint32_t	m_numOf512bitBlocks;	/**< in blocks */
+  uint32_t	m_msgInitCycles;		/**< in cycles */
+  uint32_t	m_preProcessingCycles;	/**< in cycles */
+  uint32_t	m_expansionCycles;		/**< in cycles, not part of m_totalCycles */
+  uint32_t	m_compressionCycles;	/**< in cycles */
+  uint32_t	m_totalCycles;			/**< in cycles, msg_init + pre_processing + compression */
+};
+typedef struct sBENCH_result BENCH_result_t;
+
+
+/*****************************************************************************/
+/* Local variable definitions ('static')                                     */
+/*****************************************************************************/
+
+//cycles of two back-to-back TIMER_getCycles(), subtracted from every measured phase
+static uint32_t BENCH_timerOverhead = 0;
+
+#if !defined(__nios2__)
+//written to push the message schedule out of the caches of the host, there is no cache flush in user space
+static volatile uint8_t BENCH_evictionBuffer[BENCH_EVICTION_SIZE_IN_BYTES];
+#endif
+
+
+/*****************************************************************************/
+/* Local function prototypes ('static')                                      */
+/*****************************************************************************/
+
+/**
+ * \brief Measures the cycles of two back-to-back TIMER_getCycles().
+ *
+ * \return the smallest of several measurements, in cycles
+ */
+static uint32_t BENCH_measureTimerOverhead(void);
+
+/**
+ * \brief Cycles between two timer values, without the timer overhead.
+ *
+ * \param uint32_t start : IN - timer value at the start
+ * \param uint32_t end : IN - timer value at the end
+ * \return the cycles, 0 if the phase was shorter than the timer overhead
+ */
+static uint32_t BENCH_elapsed(uint32_t start, uint32_t end);
+
+/**
+ * \brief Checks if a message of the given length and its Objects fit into the heap.
+ *
+ * \param uint32_t length : IN - length of the message, in bytes
+ * \return TRUE if the memory of one run can be allocated, otherwise FALSE
+ */
+static boolean_t BENCH_isFitting(uint32_t length);
+
+/**
+ * \brief Runs one message size BENCH_NUM_OF_RUNS times and prints the fastest run.
+ *
+ * \param uint32_t length : IN - length of the message, in bytes
+ */
+static void BENCH_runMessageSize(uint32_t length);
+
+/**
+ * \brief Hashes one message with the Message and SHA-1 Packet Objects and measures every phase.
+ *
+ * \param const char* input : IN - the null-terminated input string
+ * \param uint32_t length : IN - length of the input string, in bytes
+ * \param BENCH_result_t* result : OUT - cycles of the phases
+ */
+static void BENCH_runOnce(const char* input, uint32_t length, BENCH_result_t* result);
+
+/**
+ * \brief Prints one CSV line of results.
+ *
+ * \param const BENCH_result_t* result : IN - cycles of the phases
+ */
+static void BENCH_printResult(const BENCH_result_t* result);
+
+/**
+ * \brief Times both message schedules of the unrolled Compression Function, with a warm and a cold data cache.
+ */
+static void BENCH_compareSchedules(void);
+
+/**
+ * \brief Cycles per block of one message schedule, BENCH_NUM_OF_RUNS times, the fastest run.
+ *
+ * \param void (*compress)(uint32_t*, const uint32_t*, const uint32_t*) : IN - the Compression Function
+ * \param boolean_t isCold : IN - TRUE to flush the data cache before each block
+ * \return cycles per block, times 100
+ */
+static uint64_t BENCH_measureSchedule(void (*compress)(uint32_t*, const uint32_t*, const uint32_t*), boolean_t isCold);
+
+/**
+ * \brief Write back and invalidate the whole data cache, or push everything out of the caches of the host.
+ */
+static void BENCH_flushDataCache(void);
+
+/**
+ * \brief Prints "<name>,<warm>,<cold>" of one message schedule, both with 2 decimal places.
+ *
+ * \param const char* name : IN - name of the schedule
+ * \param uint64_t warmTimes100 : IN - cycles per block with a warm data cache, times 100
+ * \param uint64_t coldTimes100 : IN - cycles per block with a cold data cache, times 100
+ */
+static void BENCH_printSchedule(const char* name, uint64_t warmTimes100, uint64_t coldTimes100);
+
+/**
+ * \brief Prints the difference of two numbers with 2 decimal places, with a sign if it is negative.
+ *
+ * \param uint64_t minuendTimes100 : IN - the first number multiplied by 100
+ * \param uint64_t subtrahendTimes100 : IN - the second number multiplied by 100
+ */
+static void BENCH_printDifference(uint64_t minuendTimes100, uint64_t subtrahendTimes100);
+
+/**
+ * \brief Prints an unsigned decimal number, alt_printf() only knows %x.
+ *
+ * \param uint32_t value : IN - the number
+ */
+static void BENCH_printDecimal(uint32_t value);
+
+/**
+ * \brief Prints a number with 2 decimal places.
+ *
+ * \param uint64_t valueTimes100 : IN - the number multiplied by 100
+ */
+static void BENCH_printHundredths(uint64_t valueTimes100);
+
+
+/*****************************************************************************/
+/* Function implementation - global ('extern') and local ('static')          */
+/*****************************************************************************/
+
+/**
+ * \brief Runs the benchmark over all message sizes and prints the results.
+ */
+void BENCH_run(void)
+{
+	TIMER_init();
+	BENCH_timerOverhead = BENCH_measureTimerOverhead();
+
+	alt_putstr("#BENCH,compression,");
+	BENCH_printDecimal(SHA1_CONFIG_COMPRESSION);
+	alt_putstr(",schedule,");
+	BENCH_printDecimal(SHA1_CONFIG_SCHEDULE);
+	alt_putstr(",timer_hz,");
+	BENCH_printDecimal(TIMER_FREQ);
+	alt_putstr(",timer_overhead,");
+	BENCH_printDecimal(BENCH_timerOverhead);
+	alt_putstr("\n#BENCH,bytes,blocks,msg_init,pre_processing,expansion,compression,total,cycles_per_byte,mb_per_s\n");
+
+	//0 bytes, then powers of two as long as they fit
+	uint32_t largestLength = 0;
+	BENCH_runMessageSize(0);
+
+	for(uint32_t length = 1; length <= BENCH_MAX_MESSAGE_LENGTH; length *= 2)
+	{
+		if(FALSE == BENCH_isFitting(length))
+		{
+			break;
+		}
+
+		BENCH_runMessageSize(length);
+		largestLength = length;
+	}
+
+	//close the gap to the next power of two, down to one 512-bit block
+	uint32_t lastPowerOfTwo = largestLength;
+	for(uint32_t step = largestLength / 2; step >= SHA1_BLOCK_SIZE_IN_BYTES; step /= 2)
+	{
+		if(((largestLength + step) <= BENCH_MAX_MESSAGE_LENGTH) && (TRUE == BENCH_isFitting(largestLength + step)))
+		{
+			largestLength += step;
+		}
+	}
+
+	if(largestLength != lastPowerOfTwo)
+	{
+		BENCH_runMessageSize(largestLength);
+	}
+
+	alt_putstr("#BENCH,largest_bytes,");
+	BENCH_printDecimal(largestLength);
+	alt_putstr("\n");
+
+	BENCH_compareSchedules();
+}
+
+/**
+ * \brief Measures the cycles of two back-to-back TIMER_getCycles().
+ *
+ * \return the smallest of several measurements, in cycles
+ */
+static uint32_t BENCH_measureTimerOverhead(void)
+{
+	uint32_t overhead = 0xFFFFFFFF;
+
+	for(uint8_t i = 0; i < 8; i++)
+	{
+		uint32_t start = TIMER_getCycles();
+		uint32_t end = TIMER_getCycles();
+
+		if((end - start) < overhead)
+		{
+			overhead = end - start;
+		}
+	}
+
+	return overhead;
+}
+
+/**
+ * \brief Cycles between two timer values, without the timer overhead.
+ *
+ * \param uint32_t start : IN - timer value at the start
+ * \param uint32_t end : IN - timer value at the end
+ * \return the cycles, 0 if the phase was shorter than the timer overhead
+ */
+static uint32_t BENCH_elapsed(uint32_t start, uint32_t end)
+{
+	uint32_t cycles = end - start;
+
+	return (cycles > BENCH_timerOverhead) ? (cycles - BENCH_timerOverhead) : 0;
+}
+
+/**
+ * \brief Checks if a message of the given length and its Objects fit into the heap.
+ *
+ * \param uint32_t length : IN - length of the message, in bytes
+ * \return TRUE if the memory of one run can be allocated, otherwise FALSE
+ */
+static boolean_t BENCH_isFitting(uint32_t length)
+{
+	/**
+	 * One run allocates:
+	 * - the input string:                   length + 1
+	 * - the copy in the Message Object:     length + 1
+	 * - the uint32_t array of the message:  4 bytes per 4 characters
+	 * - the 512-bit blocks of the packet:   SHA1_getNumOf512bitBlocks()
+	 * MSG_init() and SHA1_init() do not handle a failed malloc, so the whole amount is tried in advance.
+	 */
+	uint32_t footprint = (2 * (length + 1)) +
+						 (((length + 3) / 4) * sizeof(uint32_t)) +
+						 ((uint32_t)SHA1_getNumOf512bitBlocks(length) * sizeof(SHA1_512bit_block_t)) +
+						 BENCH_STACK_RESERVE_IN_BYTES;
+
+	void* probe = malloc(footprint);
+	if(probe == NULL)
+	{
+		return FALSE;
+	}
+
+	free(probe);
+
+	return TRUE;
+}
+
+/**
+ * \brief Runs one message size BENCH_NUM_OF_RUNS times and prints the fastest run.
+ *
+ * \param uint32_t length : IN - length of the message, in bytes
+ */
+static void BENCH_runMessageSize(uint32_t length)
+{
+	BENCH_result_t fastestResult;
+	BENCH_result_t result;
+
+	//printable ASCII characters, MSG_init() expects a null-terminated string
+	char* input = (char*)malloc(length + 1);
+	if(input == NULL)
+	{
+		alt_putstr("#BENCH,error,Memory allocation failed\n");
+		return;
+	}
+
+	for(uint32_t i = 0; i < length; i++)
+	{
+		input[i] = (char)('a' + (i % 26));
+	}
+	input[length] = '\0';
+
+	BENCH_runOnce(input, length, &fastestResult);
+	for(uint8_t runIndex = 1; runIndex < BENCH_NUM_OF_RUNS; runIndex++)
+	{
+		BENCH_runOnce(input, length, &result);
+
+		if(result.m_totalCycles < fastestResult.m_totalCycles)
+		{
+			fastestResult = result;
+		}
+	}
+
+	free(input);
+
+	BENCH_printResult(&fastestResult);
+}
+
+/**
+ * \brief Hashes one message with the Message and SHA-1 Packet Objects and measures every phase.
+ *
+ * \param const char* input : IN - the null-terminated input string
+ * \param uint32_t length : IN - length of the input string, in bytes
+ * \param BENCH_result_t* result : OUT - cycles of the phases
+ */
+static void BENCH_runOnce(const char* input, uint32_t length, BENCH_result_t* result)
+{
+	MSG_message_t message;
+	SHA1_packet_t packet;
+	uint32_t expandedWord[SHA1_NUM_OF_EXPANDED_WORDS_PER_BLOCK];
+
+	uint32_t startCycles = TIMER_getCycles();
+
+	MSG_init(&message, input, length);
+
+	uint32_t msgInitCycles = TIMER_getCycles();
+
+	SHA1_init(&packet, &message);
+
+	uint32_t preProcessingCycles = TIMER_getCycles();
+
+	for(uint64_t i = 0; i < packet.m_numOf512bitBlocks; i++)
+	{
+		SHA1_wordExpansion(packet.m_512bit_block[i].m_word, expandedWord);
+	}
+
+	uint32_t expansionCycles = TIMER_getCycles();
+
+	SHA1_processPacket(&packet);
+
+	uint32_t compressionCycles = TIMER_getCycles();
+
+	result->m_length = length;
+	result->m_numOf512bitBlocks = (uint32_t)packet.m_numOf512bitBlocks;
+	result->m_msgInitCycles = BENCH_elapsed(startCycles, msgInitCycles);
+	result->m_preProcessingCycles = BENCH_elapsed(msgInitCycles, preProcessingCycles);
+	result->m_expansionCycles = BENCH_elapsed(preProcessingCycles, expansionCycles);
+	result->m_compressionCycles = BENCH_elapsed(expansionCycles, compressionCycles);
+	result->m_totalCycles = result->m_msgInitCycles + result->m_preProcessingCycles + result->m_compressionCycles;
+
+	SHA1_freeMemory(&packet);
+	MSG_freeMemory(&message);
+}
+
+/**
+ * \brief Prints one CSV line of results.
+ *
+ * \param const BENCH_result_t* result : IN - cycles of the phases
+ */
+static void BENCH_printResult(const BENCH_result_t* result)
+{
+	alt_putstr("BENCH,");
+	BENCH_printDecimal(result->m_length);
+	alt_putchar(',');
+	BENCH_printDecimal(result->m_numOf512bitBlocks);
+	alt_putchar(',');
+	BENCH_printDecimal(result->m_msgInitCycles);
+	alt_putchar(',');
+	BENCH_printDecimal(result->m_preProcessingCycles);
+	alt_putchar(',');
+	BENCH_printDecimal(result->m_expansionCycles);
+	alt_putchar(',');
+	BENCH_printDecimal(result->m_compressionCycles);
+	alt_putchar(',');
+	BENCH_printDecimal(result->m_totalCycles);
+	alt_putchar(',');
+
+	//cycles/byte and MB/s are not defined for the empty message or a run below the timer resolution
+	if((result->m_length == 0) || (result->m_totalCycles == 0))
+	{
+		alt_putstr("nan,nan\n");
+		return;
+	}
+
+	BENCH_printHundredths(((uint64_t)result->m_totalCycles * 100) / result->m_length);
+	alt_putchar(',');
+
+	//MB/s = bytes / (cycles / TIMER_FREQ) / 10^6, times 100 for 2 decimal places
+	BENCH_printHundredths(((uint64_t)result->m_length * (TIMER_FREQ / 10000u)) / result->m_totalCycles);
+	alt_putchar('\n');
+}
+
+/**
+ * \brief Times both message schedules of the unrolled Compression Function, with a warm and a cold data cache.
+ */
+static void BENCH_compareSchedules(void)
+{
+	uint64_t expandedWarm = BENCH_measureSchedule(SHA1_compressUnrolledExpanded80, FALSE);
+	uint64_t rollingWarm = BENCH_measureSchedule(SHA1_compressUnrolledRolling16, FALSE);
+	uint64_t expandedCold = BENCH_measureSchedule(SHA1_compressUnrolledExpanded80, TRUE);
+	uint64_t rollingCold = BENCH_measureSchedule(SHA1_compressUnrolledRolling16, TRUE);
+
+	alt_putstr("#BENCH,schedule,warm_cycles_per_block,cold_cycles_per_block\n");
+	BENCH_printSchedule("expanded_80", expandedWarm, expandedCold);
+	BENCH_printSchedule("rolling_16", rollingWarm, rollingCold);
+
+	alt_putstr("BENCH_SCHEDULE,difference,");
+	BENCH_printDifference(expandedWarm, rollingWarm);
+	alt_putchar(',');
+	BENCH_printDifference(expandedCold, rollingCold);
+	alt_putchar('\n');
+}
+
+/**
+ * \brief Cycles per block of one message schedule, BENCH_NUM_OF_RUNS times, the fastest run.
+ *
+ * \param void (*compress)(uint32_t*, const uint32_t*, const uint32_t*) : IN - the Compression Function
+ * \param boolean_t isCold : IN - TRUE to flush the data cache before each block
+ * \return cycles per block, times 100
+ */
+static uint64_t BENCH_measureSchedule(void (*compress)(uint32_t*, const uint32_t*, const uint32_t*), boolean_t isCold)
+{
+	uint32_t block[SHA1_TOTAL_WORDS_PER_BLOCK];
+	uint32_t hash[SHA1_NUM_OF_HASH_WORDS_PER_BLOCK];
+	uint32_t nextHash[SHA1_NUM_OF_HASH_WORDS_PER_BLOCK];
+	uint32_t fastestCycles = 0xFFFFFFFF;
+
+	for(uint8_t wordIndex = 0; wordIndex < SHA1_TOTAL_WORDS_PER_BLOCK; wordIndex++)
+	{
+		block[wordIndex] = 0x61626364u + wordIndex;
+	}
+
+	for(uint8_t runIndex = 0; runIndex < BENCH_NUM_OF_RUNS; runIndex++)
+	{
+		uint32_t cycles = 0;
+
+		hash[SHA1_HASH_A] = SHA1_INIT_HASH_A;
+		hash[SHA1_HASH_B] = SHA1_INIT_HASH_B;
+		hash[SHA1_HASH_C] = SHA1_INIT_HASH_C;
+		hash[SHA1_HASH_D] = SHA1_INIT_HASH_D;
+		hash[SHA1_HASH_E] = SHA1_INIT_HASH_E;
+
+		if(FALSE == isCold)
+		{
+			uint32_t startCycles = TIMER_getCycles();
+
+			//each block depends on the hash of the one before, like the blocks of a message
+			for(uint32_t blockIndex = 0; blockIndex < BENCH_SCHEDULE_NUM_OF_BLOCKS; blockIndex++)
+			{
+				compress(nextHash, block, hash);
+				compress(hash, block, nextHash);
+			}
+
+			cycles = BENCH_elapsed(startCycles, TIMER_getCycles());
+		}
+		else
+		{
+			for(uint32_t blockIndex = 0; blockIndex < (2 * BENCH_SCHEDULE_NUM_OF_BLOCKS); blockIndex++)
+			{
+				BENCH_flushDataCache();
+
+				uint32_t startCycles = TIMER_getCycles();
+
+				compress(nextHash, block, hash);
+
+				cycles += BENCH_elapsed(startCycles, TIMER_getCycles());
+
+				memcpy(hash, nextHash, sizeof(hash));
+			}
+		}
+
+		if(cycles < fastestCycles)
+		{
+			fastestCycles = cycles;
+		}
+	}
+
+	return ((uint64_t)fastestCycles * 100) / (2 * BENCH_SCHEDULE_NUM_OF_BLOCKS);
+}
+
+/**
+ * \brief Write back and invalidate the whole data cache, or push everything out of the caches of the host.
+ */
+static void BENCH_flushDataCache(void)
+{
+#if defined(__nios2__)
+	//flushd takes the line of the index of the address, whatever address is cached in it, like alt_dcache_flush_all()
+	for(uint32_t address = 0; address < ALT_CPU_DCACHE_SIZE; address += ALT_CPU_DCACHE_LINE_SIZE)
+	{
+		__builtin_flushd((void*)address);
+	}
+#else
+	for(uint32_t byteIndex = 0; byteIndex < BENCH_EVICTION_SIZE_IN_BYTES; byteIndex += 64)
+	{
+		BENCH_evictionBuffer[byteIndex]++;
+	}
+#endif
+}
+
+/**
+ * \brief Prints "<name>,<warm>,<cold>" of one message schedule, both with 2 decimal places.
+ *
+ * \param const char* name : IN - name of the schedule
+ * \param uint64_t warmTimes100 : IN - cycles per block with a warm data cache, times 100
+ * \param uint64_t coldTimes100 : IN - cycles per block with a cold data cache, times 100
+ */
+static void BENCH_printSchedule(const char* name, uint64_t warmTimes100, uint64_t coldTimes100)
+{
+	alt_putstr("BENCH_SCHEDULE,");
+	alt_putstr(name);
+	alt_putchar(',');
+	BENCH_printHundredths(warmTimes100);
+	alt_putchar(',');
+	BENCH_printHundredths(coldTimes100);
+	alt_putchar('\n');
+}
+
+/**
+ * \brief Prints the difference of two numbers with 2 decimal places, with a sign if it is negative.
+ *
+ * \param uint64_t minuendTimes100 : IN - the first number multiplied by 100
+ * \param uint64_t subtrahendTimes100 : IN - the second number multiplied by 100
+ */
+static void BENCH_printDifference(uint64_t minuendTimes100, uint64_t subtrahendTimes100)
+{
+	if(minuendTimes100 < subtrahendTimes100)
+	{
+		alt_putchar('-');
+		BENCH_printHundredths(subtrahendTimes100 - minuendTimes100);
+	}
+	else
+	{
+		BENCH_printHundredths(minuendTimes100 - subtrahendTimes100);
+	}
+}
+
+/**
+ * \brief Prints an unsigned decimal number, alt_printf() only knows %x.
+ *
+ * \param uint32_t value : IN - the number
+ */
+static void BENCH_printDecimal(uint32_t value)
+{
+	//4294967295 has 10 digits
+	char digit[10];
+	uint8_t numOfDigits = 0;
+
+	do
+	{
+		digit[numOfDigits] = (char)('0' + (value % 10));
+		value /= 10;
+		numOfDigits++;
+	} while(value != 0);
+
+	while(numOfDigits > 0)
+	{
+		numOfDigits--;
+		alt_putchar(digit[numOfDigits]);
+	}
+}
+
+/**
+ * \brief Prints a number with 2 decimal places.
+ *
+ * \param uint64_t valueTimes100 : IN - the number multiplied by 100
+ */
+static void BENCH_printHundredths(uint64_t valueTimes100)
+{
+	uint32_t hundredths = (uint32_t)(valueTimes100 % 100);
+
+	BENCH_printDecimal((uint32_t)(valueTimes100 / 100));
+	alt_putchar('.');
+	alt_putchar((char)('0' + (hundredths / 10)));
+	alt_putchar((char)('0' + (hundredths % 10)));
+}
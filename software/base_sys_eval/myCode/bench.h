@@ -0,0 +1,83 @@
+/**
+* \file   bench.h
+* \author Trung Tin Nguyen (1120436), and Dung Anh Huynh Pham (764527)
+* \date   17.10.2026
+*
+* \brief Benchmark mode of the firmware: cycles of every phase of the SHA-1 Packet Object
+*
+* Messages of 0 bytes, 1 byte, 2 bytes, 4 bytes, ... and finally the largest one that still fits into the heap
+* are hashed like main() does it. The cycles of each phase are measured with sys_timer (see "timer.h"):
+*
+* - msg_init:       MSG_init()
+* - pre_processing: SHA1_init(), allocation and padding of the 512-bit blocks
+* - expansion:      SHA1_wordExpansion() of all blocks, measured on its own. The Compression Functions do their
+*                   own expansion (SHA1_COMPRESSION_UNROLLED even interleaved with the rounds), so it is not
+*                   part of the total, it only shows how much of the compression is spent on the schedule.
+* - compression:    the sha_1() loop over all blocks
+*
+* Every size is run BENCH_NUM_OF_RUNS times, the run with the smallest total is printed.
+* The output is CSV over the JTAG UART, one line per message size, lines starting with '#' are comments:
+*
+*   #BENCH,bytes,blocks,msg_init,pre_processing,expansion,compression,total,cycles_per_byte,mb_per_s
+*   BENCH,64,2,1234,5678,...
+*
+* Then both message schedules of the unrolled Compression Function, SHA1_compressUnrolledExpanded80() and
+* SHA1_compressUnrolledRolling16(), are timed on the same block, whatever SHA1_CONFIG_SCHEDULE selects:
+*
+* - warm: BENCH_SCHEDULE_NUM_OF_BLOCKS blocks back to back, the schedule stays in the data cache.
+* - cold: the data cache is flushed before each block (flushd over the whole cache on the Nios II, a write of
+*         BENCH_EVICTION_SIZE_IN_BYTES on the host), so every line of the schedule misses once.
+*
+*   #BENCH,schedule,warm_cycles_per_block,cold_cycles_per_block
+*   BENCH_SCHEDULE,expanded_80,...
+*   BENCH_SCHEDULE,rolling_16,...
+*   BENCH_SCHEDULE,difference,...       expanded_80 - rolling_16, the cost of the 80-word array
+*
+* \note <notes>
+* \todo <todos>
+* \warning Uses sys_timer, see "timer.h".
+*
+*  Changelog:\n
+*  - <version; data of change; author>
+*            - <description of the change>
+*
+* \copyright Copyright 2023
+* Department of electrical engineering and information technology, Hochschule Darmstadt - University of applied sciences (h_da). All Rights Reserved.
+* Permission to use, copy, modify, and distribute this software and its documentation for educational, and research purposes in the context of non-commercial
+* (unless permitted by h_da) and official h_da projects, is hereby granted for enrolled students of h_da, provided that the above copyright notice,
+* this paragraph and the following paragraph appear in all copies, modifications, and distributions.
+*
+* Contact Prof.Dr. C. Jakob, christian.jakob@h-da.de, Birkenweg 8 64295 Darmstadt - GERMANY for commercial requests.
+*
+* \warning This software is a PROTOTYPE version and is not designed or intended for use in production, especially not for safety-critical applications!
+* The user represents and warrants that it will NOT use or redistribute the Software for such purposes.
+* This prototype is for research purposes only. This software is provided "AS IS," without a warranty of any kind.
+**/
+
+#ifndef MYCODE_BENCH_H_
+#define MYCODE_BENCH_H_
+
+#include "global.h"
+
+
+/*****************************************************************************/
+/* Global pre-processor symbols/macros and type declarations                 */
+/*****************************************************************************/
+
+#define BENCH_NUM_OF_RUNS				3					/**< runs per message size */
+#define BENCH_MAX_MESSAGE_LENGTH		(1024u * 1024u)		/**< in bytes, upper limit for the host, the board runs out of heap long before */
+#define BENCH_STACK_RESERVE_IN_BYTES	2048				/**< in bytes, the HAL heap grows towards the stack, keep this much free */
+#define BENCH_SCHEDULE_NUM_OF_BLOCKS	64					/**< blocks per message schedule and cache state */
+#define BENCH_EVICTION_SIZE_IN_BYTES	(1024u * 1024u)		/**< in bytes, written on the host to push the schedule out of its caches */
+
+
+/*****************************************************************************/
+/* API functions                                                             */
+/*****************************************************************************/
+
+/**
+ * \brief Runs the benchmark over all message sizes and prints the results.
+ */
+void BENCH_run(void);
+
+#endif /* MYCODE_BENCH_H_ */
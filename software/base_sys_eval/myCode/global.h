@@ -35,16 +35,31 @@
 /* Type definitions ('typedef')                                        		 */
 /*****************************************************************************/
 
+#if defined(__nios2__)
+
 typedef signed 		char    	sint8_t;            /**< \brief         -128 .. +127            */
 typedef unsigned 	char  		uint8_t;            /**< \brief            0 .. 255             */
 typedef signed 		short   	sint16_t;           /**< \brief       -32768 .. +32767          */
 typedef unsigned 	short 		uint16_t;           /**< \brief            0 .. 65535           */
 typedef signed 		long    	sint32_t;           /**< \brief  -2147483648 .. +2147483647     */
 typedef unsigned 	long  		uint32_t;           /**< \brief            0 .. 4294967295      */
-typedef 			float   	float32_t;	        /**< \brief  single precision floating point number (4 byte) */
-typedef 			double  	float64_t;	        /**< \brief  double precision floating point number (8 byte) */
 typedef signed 		long long   sint64_t;           /**< \brief -9223372036854775808 .. +9223372036854775807     */
 typedef unsigned 	long long 	uint64_t;           /**< \brief                    0 .. 18446744073709551615     */
+
+#else
+
+//host build (see "platform.h"): long is 64 bit on x86_64 Linux, so take the exact-width types of the C library
+#include <stdint.h>
+
+typedef 			int8_t    	sint8_t;            /**< \brief         -128 .. +127            */
+typedef 			int16_t   	sint16_t;           /**< \brief       -32768 .. +32767          */
+typedef 			int32_t    	sint32_t;           /**< \brief  -2147483648 .. +2147483647     */
+typedef 			int64_t   	sint64_t;           /**< \brief -9223372036854775808 .. +9223372036854775807     */
+
+#endif
+
+typedef 			float   	float32_t;	        /**< \brief  single precision floating point number (4 byte) */
+typedef 			double  	float64_t;	        /**< \brief  double precision floating point number (8 byte) */
 typedef unsigned	char  		boolean_t; 	        /**< \brief  for use with TRUE/FALSE        */
 typedef 			char    	char_t;		        /**< \brief	Character Datatype*/
 
@@ -32,7 +32,9 @@
 #define MYCODE_LED_H_
 
 
+#if defined(__nios2__)
 #include "system.h"
+#endif
 
 
 typedef unsigned int alt_u32;
@@ -54,7 +56,13 @@ typedef struct {
 //Base address of the PIO output unit SYS_PIO_OUT_BASE in "system.h"
 //append that address into this pointer expression
 //MSB is set to one to bypass the data cache
+#if defined(__nios2__)
 #define LEDS (*((PIO_TYPE *) 0x80011020 ))
+#else
+//host build: there is no PIO, the registers are a plain variable in "platform_host.c"
+extern PIO_TYPE PLATFORM_hostLeds;
+#define LEDS PLATFORM_hostLeds
+#endif
 
 
 #endif /* MYCODE_LED_H_ */
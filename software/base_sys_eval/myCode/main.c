@@ -8,22 +8,55 @@
  ============================================================================
  */
 
-#include "system.h"
-#include "sys/alt_stdio.h"	//to print out on console
+#include "platform.h"	//console, LEDs and "system.h" of the DECA board, or their host stand-ins
 #include <string.h> 		//for the usage of strlen()
 
 //user-defined files
 #include "global.h" //typedefs for common datatypes
 #include "sha1.h"   //SHA-1 implementation file
+#include "sha1_config.h" //Configuration Macros of the SHA-1 implementation
 #include "msg.h"	//file containing API to convert input string into uint32_t array representation
-#include "led.h"	//This file configure the LEDs
+#include "bench.h"	//benchmark mode, enabled with SHA1_CONFIG_ENABLE_BENCHMARK
 
 /**
- * \brief This function compares the output hash values and compare the correct one, then turn the LEDs accordingly
+ * \brief This function compares the output hash values with the correct one
  *
- * \param SHA1_packet_t* packet : IN - the SHA-1 Packet Object
+ * \param const uint32_t* hash : IN - the 5 final hash words
+ * \return TRUE if all 5 hash words are correct, otherwise FALSE
  */
-void showResultOnLEDs(SHA1_packet_t* packet);
+boolean_t isCorrectHash(const uint32_t* hash);
+
+/**
+ * \brief This function turns the LEDs according to the result of the hash comparison
+ *
+ * \param boolean_t isCorrect : IN - TRUE if the computed hash values are correct
+ */
+void showResultOnLEDs(boolean_t isCorrect);
+
+/**
+ * \brief This function checks bit-for-bit that the unrolled Compression Function gives the same
+ * 		  result as the original per-round stage dispatch, on pseudo-random 512-bit blocks.
+ *
+ * \param uint32_t numOfBlocks : IN - number of pseudo-random blocks to compare
+ * \return TRUE if both implementations agree on every block, otherwise FALSE
+ */
+boolean_t isUnrolledCompressionConsistent(uint32_t numOfBlocks);
+
+/**
+ * \brief This function hashes a second message with the SHA-1 Packet Object, to check that
+ * 		  SHA1_init() does not depend on the state left behind by the previous message.
+ *
+ * \return TRUE if the hash of the second message is correct, otherwise FALSE
+ */
+boolean_t isRepeatedInitCorrect(void);
+
+/**
+ * \brief This function hashes messages with SHA1_hashBuffer() straight from a byte buffer:
+ * 		  the input string at an aligned and at an unaligned address, and a binary message with an embedded '\0'.
+ *
+ * \return TRUE if all hashes are correct, otherwise FALSE
+ */
+boolean_t isZeroCopyHashCorrect(void);
 
 //the required input string
 #define	INPUT_STRING "FSOC23/24 is fun!"
@@ -32,6 +65,18 @@ void showResultOnLEDs(SHA1_packet_t* packet);
 static uint32_t correctHashValues[SHA1_NUM_OF_HASH_WORDS_PER_BLOCK] =
 	{0xa617f4b3, 0xa108b6dd, 0x82bb8c4a, 0x16ab0b35, 0x2a32a0b9};
 
+//a second input string (FIPS PUB 180-1, Appendix A) and its correct/expected SHA-1 hash values
+#define	SECOND_INPUT_STRING "abc"
+static uint32_t secondCorrectHashValues[SHA1_NUM_OF_HASH_WORDS_PER_BLOCK] =
+	{0xa9993e36, 0x4706816a, 0xba3e2571, 0x7850c26c, 0x9cd0d89d};
+
+//a binary message: the input string with a '\0' instead of the space after "FSOC23/24"
+#define	BINARY_INPUT_LENGTH	17
+static const uint8_t binaryInput[BINARY_INPUT_LENGTH] =
+	{'F', 'S', 'O', 'C', '2', '3', '/', '2', '4', '\0', 'i', 's', ' ', 'f', 'u', 'n', '!'};
+static uint32_t binaryCorrectHashValues[SHA1_NUM_OF_HASH_WORDS_PER_BLOCK] =
+	{0xcb0ef6a0, 0x451a90fe, 0xa62b8e18, 0x32a1edf5, 0x863bc2f3};
+
 int main(void)
 {
 	//Initially, we turn OFF all LEDs, 0xFF means all OFF
@@ -70,72 +115,232 @@ int main(void)
 	 * run the SHA-1 algorithm
 	 *
 	 * in file "sha1_config.h", you can turn the debug on or off to see the inner computations
+	 * and select the Compression Function. The blocks are chained one after the other, on the accelerator
+	 * the chaining value stays in the hardware.
 	 */
-	for(uint64_t i = 0; i < packet.m_numOf512bitBlocks; i++)
-	{
-		//operate on a single pre-processed 512-bit wide input message
-		sha_1(packet.m_512bit_block[i].m_outputHash,
-				packet.m_512bit_block[i].m_word,
-				packet.m_512bit_block[i].m_inputHash);
-
-		//takes the output hash of the current 512-bit block and assigns to the input hash of the next 512-bit block
-		SHA1_updateInputHashForNextBlock(&packet, i);
-	}
+	SHA1_processPacket(&packet);
 
 	//print out the final hash output.
 	SHA1_printFinalHash(&packet, &message);
 
-	//show the result on LEDs
-	showResultOnLEDs(&packet);
+	/**
+	 * #Step 3: hash the same input string again with the streaming SHA-1 context.
+	 *
+	 * The context only keeps one partial 512-bit block, so the input can be fed in pieces
+	 * and the memory usage does not grow with the message length.
+	 */
+	SHA1_ctx_t ctx;
+	uint32_t streamingHash[SHA1_NUM_OF_HASH_WORDS_PER_BLOCK];
+
+	SHA1_ctxInit(&ctx);
+	SHA1_ctxUpdate(&ctx, INPUT_STRING, (uint64_t)strlen(INPUT_STRING));
+	SHA1_ctxFinal(&ctx, streamingHash);
+
+	alt_printf("The streaming SHA-1 context gives\n\n");
+	alt_printf("	%x %x %x %x %x\n\n",
+			streamingHash[SHA1_HASH_A],
+			streamingHash[SHA1_HASH_B],
+			streamingHash[SHA1_HASH_C],
+			streamingHash[SHA1_HASH_D],
+			streamingHash[SHA1_HASH_E]);
+
+	//check the unrolled Compression Function against the original one
+	boolean_t isConsistent = isUnrolledCompressionConsistent(256);
+
+	alt_printf("Unrolled Compression Function matches the stage dispatch: %s\n\n",
+			isConsistent ? "yes" : "NO");
+
+	//hash a second message, SHA1_init() must start from a clean state again
+	boolean_t isSecondInitCorrect = isRepeatedInitCorrect();
+
+	alt_printf("Second SHA1_init() gives the correct hash: %s\n\n",
+			isSecondInitCorrect ? "yes" : "NO");
+
+	//hash straight from the caller's byte buffer, without MSG_init()
+	boolean_t isZeroCopyCorrect = isZeroCopyHashCorrect();
+
+	alt_printf("Zero-copy SHA1_hashBuffer() gives the correct hashes: %s\n\n",
+			isZeroCopyCorrect ? "yes" : "NO");
+
+	//show the result on LEDs, only if both ways of computing the hash give the correct result
+	uint64_t lastBlockIndex = packet.m_numOf512bitBlocks - 1;
+	showResultOnLEDs(isCorrectHash(packet.m_512bit_block[lastBlockIndex].m_outputHash) &&
+					 isCorrectHash(streamingHash) &&
+					 isConsistent &&
+					 isSecondInitCorrect &&
+					 isZeroCopyCorrect);
 
 	//release memory of the Objects at the end of program.
 	SHA1_freeMemory(&packet);
 	MSG_freeMemory(&message);
 
+#if (SHA1_CONFIG_ENABLE_BENCHMARK == 1)
+	//after the release, so that the largest message can use the whole heap
+	BENCH_run();
+#endif
+
 	return 0;
 }
 
 /**
- * \brief This function compares the output hash values and compare the correct one, then turn the LEDs accordingly
+ * \brief This function compares the output hash values with the correct one
  *
- * \param SHA1_packet_t* packet : IN - the SHA-1 Packet Object
+ * \param const uint32_t* hash : IN - the 5 final hash words
+ * \return TRUE if all 5 hash words are correct, otherwise FALSE
  */
-void showResultOnLEDs(SHA1_packet_t* packet)
+boolean_t isCorrectHash(const uint32_t* hash)
 {
-	//find the index of the last 512-bit block
-	uint64_t lastBlockIndex = packet->m_numOf512bitBlocks - 1;
+	for(uint8_t hashIndex = SHA1_HASH_A; hashIndex < SHA1_NUM_OF_HASH_WORDS_PER_BLOCK; hashIndex++)
+	{
+		if(hash[hashIndex] != correctHashValues[hashIndex])
+		{
+			return FALSE;
+		}
+	}
+
+	return TRUE;
+}
 
-	if(packet->m_512bit_block[lastBlockIndex].m_outputHash[SHA1_HASH_A] != correctHashValues[SHA1_HASH_A])
+/**
+ * \brief This function turns the LEDs according to the result of the hash comparison
+ *
+ * \param boolean_t isCorrect : IN - TRUE if the computed hash values are correct
+ */
+void showResultOnLEDs(boolean_t isCorrect)
+{
+	if(FALSE == isCorrect)
 	{
 		//0xFF means all OFF
 		LEDS.DATA_REG = 0xFF;
 		return;
 	}
-	else if(packet->m_512bit_block[lastBlockIndex].m_outputHash[SHA1_HASH_B] != correctHashValues[SHA1_HASH_B])
+
+    //0x00 means all ON
+    LEDS.DATA_REG = 0x00;
+}
+
+/**
+ * \brief This function checks bit-for-bit that the unrolled Compression Function gives the same
+ * 		  result as the original per-round stage dispatch, on pseudo-random 512-bit blocks.
+ *
+ * \param uint32_t numOfBlocks : IN - number of pseudo-random blocks to compare
+ * \return TRUE if both implementations agree on every block, otherwise FALSE
+ */
+boolean_t isUnrolledCompressionConsistent(uint32_t numOfBlocks)
+{
+	//xorshift32 pseudo-random generator, the seed is arbitrary but must not be 0
+	uint32_t randomState = 0x2545F491;
+
+	uint32_t word[SHA1_TOTAL_WORDS_PER_BLOCK];
+	uint32_t prevHash[SHA1_NUM_OF_HASH_WORDS_PER_BLOCK];
+	uint32_t referenceHash[SHA1_NUM_OF_HASH_WORDS_PER_BLOCK];
+	uint32_t unrolledHash[SHA1_NUM_OF_HASH_WORDS_PER_BLOCK];
+
+	for(uint32_t blockIndex = 0; blockIndex < numOfBlocks; blockIndex++)
 	{
-		//0xFF means all OFF
-		LEDS.DATA_REG = 0xFF;
-		return;
+		for(uint8_t wordIndex = 0; wordIndex < SHA1_TOTAL_WORDS_PER_BLOCK; wordIndex++)
+		{
+			randomState ^= randomState << 13;
+			randomState ^= randomState >> 17;
+			randomState ^= randomState << 5;
+			word[wordIndex] = randomState;
+		}
+
+		for(uint8_t hashIndex = SHA1_HASH_A; hashIndex < SHA1_NUM_OF_HASH_WORDS_PER_BLOCK; hashIndex++)
+		{
+			randomState ^= randomState << 13;
+			randomState ^= randomState >> 17;
+			randomState ^= randomState << 5;
+			prevHash[hashIndex] = randomState;
+		}
+
+		SHA1_compressStageDispatch(referenceHash, word, prevHash);
+		SHA1_compressUnrolled(unrolledHash, word, prevHash);
+
+		for(uint8_t hashIndex = SHA1_HASH_A; hashIndex < SHA1_NUM_OF_HASH_WORDS_PER_BLOCK; hashIndex++)
+		{
+			if(referenceHash[hashIndex] != unrolledHash[hashIndex])
+			{
+				return FALSE;
+			}
+		}
 	}
-	else if (packet->m_512bit_block[lastBlockIndex].m_outputHash[SHA1_HASH_C] != correctHashValues[SHA1_HASH_C])
+
+	return TRUE;
+}
+
+/**
+ * \brief This function hashes a second message with the SHA-1 Packet Object, to check that
+ * 		  SHA1_init() does not depend on the state left behind by the previous message.
+ *
+ * \return TRUE if the hash of the second message is correct, otherwise FALSE
+ */
+boolean_t isRepeatedInitCorrect(void)
+{
+	MSG_message_t message;
+	SHA1_packet_t packet;
+
+	MSG_init(&message, SECOND_INPUT_STRING, (uint32_t)strlen(SECOND_INPUT_STRING));
+	SHA1_init(&packet, &message);
+
+	SHA1_processPacket(&packet);
+
+	boolean_t isCorrect = TRUE;
+	uint64_t lastBlockIndex = packet.m_numOf512bitBlocks - 1;
+
+	for(uint8_t hashIndex = SHA1_HASH_A; hashIndex < SHA1_NUM_OF_HASH_WORDS_PER_BLOCK; hashIndex++)
 	{
-		//0xFF means all OFF
-		LEDS.DATA_REG = 0xFF;
-		return;
+		if(packet.m_512bit_block[lastBlockIndex].m_outputHash[hashIndex] != secondCorrectHashValues[hashIndex])
+		{
+			isCorrect = FALSE;
+		}
+	}
+
+	SHA1_freeMemory(&packet);
+	MSG_freeMemory(&message);
+
+	return isCorrect;
+}
+
+/**
+ * \brief This function hashes messages with SHA1_hashBuffer() straight from a byte buffer:
+ * 		  the input string at an aligned and at an unaligned address, and a binary message with an embedded '\0'.
+ *
+ * \return TRUE if all hashes are correct, otherwise FALSE
+ */
+boolean_t isZeroCopyHashCorrect(void)
+{
+	//word-aligned storage, so that both the aligned and the unaligned load path can be used
+	uint32_t alignedStorage[SHA1_TOTAL_WORDS_PER_BLOCK + 1];
+	uint8_t* alignedBuffer = (uint8_t*)alignedStorage;
+	uint32_t inputLength = (uint32_t)strlen(INPUT_STRING);
+	uint32_t hash[SHA1_NUM_OF_HASH_WORDS_PER_BLOCK];
+
+	//aligned address
+	memcpy(alignedBuffer, INPUT_STRING, inputLength);
+	SHA1_hashBuffer(hash, alignedBuffer, inputLength);
+	if(FALSE == isCorrectHash(hash))
+	{
+		return FALSE;
 	}
-	else if (packet->m_512bit_block[lastBlockIndex].m_outputHash[SHA1_HASH_D] != correctHashValues[SHA1_HASH_D])
+
+	//unaligned address
+	memcpy(alignedBuffer + 1, INPUT_STRING, inputLength);
+	SHA1_hashBuffer(hash, alignedBuffer + 1, inputLength);
+	if(FALSE == isCorrectHash(hash))
 	{
-		//0xFF means all OFF
-		LEDS.DATA_REG = 0xFF;
-		return;
+		return FALSE;
 	}
-	else if (packet->m_512bit_block[lastBlockIndex].m_outputHash[SHA1_HASH_E] != correctHashValues[SHA1_HASH_E])
+
+	//binary message, strlen() would stop at the embedded '\0'
+	SHA1_hashBuffer(hash, binaryInput, BINARY_INPUT_LENGTH);
+	for(uint8_t hashIndex = SHA1_HASH_A; hashIndex < SHA1_NUM_OF_HASH_WORDS_PER_BLOCK; hashIndex++)
 	{
-		//0xFF means all OFF
-		LEDS.DATA_REG = 0xFF;
-		return;
+		if(hash[hashIndex] != binaryCorrectHashValues[hashIndex])
+		{
+			return FALSE;
+		}
 	}
 
-    //0x00 means all ON
-    LEDS.DATA_REG = 0x00;
+	return TRUE;
 }
@@ -24,7 +24,7 @@
 /*****************************************************************************/
 /* Include files                                                             */
 /*****************************************************************************/
-#include "sys/alt_stdio.h"
+#include "platform.h"	//console output
 #include <stdlib.h>	//for the usage of malloc
 #include <string.h> //for the usage of strlen()
 
@@ -87,6 +87,12 @@ void MSG_init(MSG_message_t* message, const char* string, uint32_t stringLength)
 		message->m_uint32Array[i/4] = (message->m_uint32Array[i/4] << 8) | message->m_string[i];
 	}
 
+	//the empty string has no element to align
+	if(message->m_numOfElementsInUint32Array == 0)
+	{
+		return;
+	}
+
 	//check if there are leading zeros and then perform a left shift
 	uint32_t lastElementIndex = message->m_numOfElementsInUint32Array - 1;
 
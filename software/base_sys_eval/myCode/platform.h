@@ -0,0 +1,57 @@
+/**
+* \file   platform.h
+* \author Trung Tin Nguyen (1120436), and Dung Anh Huynh Pham (764527)
+* \date   17.10.2026
+*
+* \brief Platform layer: console output and the LEDs, on the DECA board or on a Linux host
+*
+* On the Nios II (__nios2__) this file only includes the HAL headers, nothing changes for the firmware.
+* On any other target the alt_* console functions are mapped to stdio, and the LEDs are a plain variable
+* (see "led.h" and "platform_host.c"), so that the SHA-1 code can be built, tested and profiled with
+* software/sha1_host/Makefile.
+*
+* \note alt_printf() only knows %x, %s and %c, so every format string in myCode is also valid for printf().
+* \todo <todos>
+* \warning <warnings, e.g. dependencies, order of execution etc.>
+*
+*  Changelog:\n
+*  - <version; data of change; author>
+*            - <description of the change>
+*
+* \copyright Copyright 2023
+* Department of electrical engineering and information technology, Hochschule Darmstadt - University of applied sciences (h_da). All Rights Reserved.
+* Permission to use, copy, modify, and distribute this software and its documentation for educational, and research purposes in the context of non-commercial
+* (unless permitted by h_da) and official h_da projects, is hereby granted for enrolled students of h_da, provided that the above copyright notice,
+* this paragraph and the following paragraph appear in all copies, modifications, and distributions.
+*
+* Contact Prof.Dr. C. Jakob, christian.jakob@h-da.de, Birkenweg 8 64295 Darmstadt - GERMANY for commercial requests.
+*
+* \warning This software is a PROTOTYPE version and is not designed or intended for use in production, especially not for safety-critical applications!
+* The user represents and warrants that it will NOT use or redistribute the Software for such purposes.
+* This prototype is for research purposes only. This software is provided "AS IS," without a warranty of any kind.
+**/
+
+#ifndef PLATFORM_H_
+#define PLATFORM_H_
+
+#if defined(__nios2__)
+
+#include "system.h"
+#include "sys/alt_stdio.h"	//to print out on console
+
+#else
+
+#include <stdio.h>			//console output of the host
+
+/**
+ * \brief Console output of the Nios II HAL, mapped to stdio.
+ */
+#define alt_putstr(str)		fputs((str), stdout)
+#define alt_putchar(c)		putchar(c)
+#define alt_printf			printf
+
+#endif
+
+#include "led.h"	//This file configure the LEDs
+
+#endif /* PLATFORM_H_ */
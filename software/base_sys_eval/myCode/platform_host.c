@@ -0,0 +1,37 @@
+/**
+* \file   platform_host.c
+* \author Trung Tin Nguyen (1120436), and Dung Anh Huynh Pham (764527)
+* \date   17.10.2026
+*
+* \brief Host build only: stand-in for the LEDs PIO of the DECA board
+*
+* Not part of the Nios II build. The registers are a plain variable, so main() can write the LEDs as on the board.
+*
+* \copyright Copyright 2023
+* Department of electrical engineering and information technology, Hochschule Darmstadt - University of applied sciences (h_da). All Rights Reserved.
+* Permission to use, copy, modify, and distribute this software and its documentation for educational, and research purposes in the context of non-commercial
+* (unless permitted by h_da) and official h_da projects, is hereby granted for enrolled students of h_da, provided that the above copyright notice,
+* this paragraph and the following paragraph appear in all copies, modifications, and distributions.
+*
+* Contact Prof.Dr. C. Jakob, christian.jakob@h-da.de, Birkenweg 8 64295 Darmstadt - GERMANY for commercial requests.
+*
+* \warning This software is a PROTOTYPE version and is not designed or intended for use in production, especially not for safety-critical applications!
+* The user represents and warrants that it will NOT use or redistribute the Software for such purposes.
+* This prototype is for research purposes only. This software is provided "AS IS," without a warranty of any kind.
+*/
+
+
+/*****************************************************************************/
+/* Include files                                                             */
+/*****************************************************************************/
+#include "platform.h"
+
+
+/*****************************************************************************/
+/* Global variable definitions (declared in header)                          */
+/*****************************************************************************/
+
+/**
+ * \brief Registers of the LEDs PIO on the host, 0xFF means all OFF like on the board.
+ */
+PIO_TYPE PLATFORM_hostLeds = {0xFF, 0, 0, 0, 0, 0};
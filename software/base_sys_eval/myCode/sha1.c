@@ -21,24 +21,69 @@
 /*****************************************************************************/
 /* Include files                                                             */
 /*****************************************************************************/
-#include "sys/alt_stdio.h"	//to print out on Eclipse Console
+#include "platform.h"	//to print out on Eclipse Console (or stdout on the host)
 #include <stdlib.h>	//for the usage of malloc
 #include <assert.h> // for assert()
+#include <stddef.h> // for size_t
+#include <string.h> // for memcpy()
+#if !defined(__nios2__)
+#include <pthread.h> // for SHA1_powSearchParallel()
+#endif
 
 #include "sha1.h"
 #include "sha1_config.h"
+#include "sha1_rounds.h"
+
+#if (SHA1_CONFIG_COMPRESSION == SHA1_COMPRESSION_X86_SHA_NI)
+#include "sha1_ni.h"
+#elif (SHA1_CONFIG_COMPRESSION == SHA1_COMPRESSION_AVALON_ACCEL)
+#include "sha1_accel.h"
+#endif
+#include "sha1_ci.h"
 
 
 /*****************************************************************************/
-/* Local variable definitions ('static')                                     */
+/* Local pre-processor symbols/macros ('#define')                            */
 /*****************************************************************************/
 
 /**
-* \brief array of 80 expanded words to be processed in the Compression Function
-* 		 for each 512-bit block
-*/
-static uint32_t SHA1_expanded_word[SHA1_NUM_OF_EXPANDED_WORDS_PER_BLOCK] = {0};
+ * \brief Word type for loading the message straight from the caller's byte buffer.
+ *
+ * With GCC the type is marked "may_alias", because the buffer may be of any type (char, struct, ...).
+ */
+#if defined(__GNUC__)
+typedef uint32_t __attribute__((__may_alias__)) SHA1_aliasedWord_t;
+#else
+typedef uint32_t SHA1_aliasedWord_t;
+#endif
+
+/**
+ * \brief Threads of SHA1_powSearchParallel() at most, including the calling one.
+ */
+#define SHA1_POW_MAX_THREADS	64
+
+
+/*****************************************************************************/
+/* Local type definitions ('typedef')                                        */
+/*****************************************************************************/
 
+#if !defined(__nios2__)
+/**
+ * \brief State of SHA1_powSearchParallel() that all threads share, the members below m_lock are guarded by it.
+ */
+struct sSHA1_powShared {
+  const SHA1_powTail_t*	m_tail;											/**< the prepared stamp */
+  const uint32_t*		m_targetMask;									/**< 5 words, see SHA1_powJob_t */
+  uint32_t				m_firstNonce;									/**< nonce of offset 0 */
+  uint32_t				m_numOfNonces;									/**< offsets 0 .. m_numOfNonces - 1 */
+  pthread_mutex_t		m_lock;											/**< guards the members below */
+  uint32_t				m_nextOffset;									/**< first offset of the next piece */
+  boolean_t				m_isFound;										/**< a thread has found a nonce */
+  uint32_t				m_foundOffset;									/**< lowest offset found so far */
+  uint32_t				m_hash[SHA1_NUM_OF_HASH_WORDS_PER_BLOCK];		/**< hash of the stamp of m_foundOffset */
+};
+typedef struct sSHA1_powShared SHA1_powShared_t;
+#endif
 
 /*****************************************************************************/
 /* Local function prototypes ('static')                                      */
@@ -60,11 +105,12 @@ static void SHA1_initInputHash(SHA1_packet_t* packet);
 static void SHA1_initOutputHash(SHA1_packet_t* packet);
 
 /**
- * \brief initialize the 16 words of each 512bit block to 0. They will be modified later.
+ * \brief initialize the 16 words of the 512bit blocks from firstBlockIndex on to 0. They will be modified later.
  *
  * \param SHA1_packet_t* packet : IN - the SHA-1 Packet Object
+ * \param uint64_t firstBlockIndex : IN - index of the first block to initialize
  */
-static void SHA1_initWords(SHA1_packet_t* packet);
+static void SHA1_initWords(SHA1_packet_t* packet, uint64_t firstBlockIndex);
 
 /**
  * \brief This function perform SHA-1 Pre-Processing step for input messages of arbitrary length.
@@ -92,32 +138,28 @@ static void SHA1_initWords(SHA1_packet_t* packet);
 static void SHA1_preProcessing(SHA1_packet_t* packet, MSG_message_t* message);
 
 /**
- * \brief This function append the ASCII characters into the 512-bit blocks
+ * \brief This function puts the ASCII characters into the 512-bit blocks
  *
- * \param SHA1_packet_t* packet : IN - the SHA-1 Packet Object
+ * The full blocks take 16 words each, the remaining words (less than 16) go into the first tail block.
+ *
+ * \param SHA1_packet_t* packet : IN/OUT - the SHA-1 Packet Object
  * \param MSG_message_t* message : IN - the Message Object that contains an uin32_t array representation of the input string
- * \param uint64_t blockIndex : IN - the block index of the current 512-bit block
- * \param uint8_t* wordIndex : IN - the word index of the words of the current 512-bit block
- * \param uint64_t* uint32ArrayIndex : IN - the index of the uint32_t array of the Message Object
+ * \param uint64_t numOfFullBlocks : IN - number of 512-bit blocks that only hold ASCII characters
  */
 static void SHA1_putASCIIinto512bitBlock(SHA1_packet_t* packet,
 										 MSG_message_t* message,
-										 uint64_t blockIndex,
-										 uint8_t* wordIndex,
-										 uint64_t* uint32ArrayIndex);
+										 uint64_t numOfFullBlocks);
 
 /**
- * \brief This function appends the padding the 512-bit block.
+ * \brief This function appends the Padding (a single '1' bit) right after the last ASCII character.
  *
- * \param SHA1_packet_t* packet : IN - the SHA-1 Packet Object
+ * \param SHA1_packet_t* packet : IN/OUT - the SHA-1 Packet Object
  * \param MSG_message_t* message : IN - the Message Object that contains an uin32_t array representation of the input string
- * \param uint64_t blockIndex : IN - the block index of the current 512-bit block
- * \param uint8_t* wordIndex : IN - the word index of the words of the current 512-bit block
+ * \param uint64_t numOfFullBlocks : IN - number of 512-bit blocks that only hold ASCII characters
  */
 static void SHA1_addPaddingInto512bitBlock(SHA1_packet_t* packet,
 										   MSG_message_t* message,
-										   uint64_t blockIndex,
-										   uint8_t* wordIndex);
+										   uint64_t numOfFullBlocks);
 
 /**
  * \brief This function appends the 64-bit representation of the original message length
@@ -125,24 +167,11 @@ static void SHA1_addPaddingInto512bitBlock(SHA1_packet_t* packet,
  * How this algorithm works is that we just put the last 64-bit representation
  * of the original message length to the last 64-bit of the last 512-bit block
  *
- * \param SHA1_packet_t* packet : IN - the SHA-1 Packet Object
+ * \param SHA1_packet_t* packet : IN/OUT - the SHA-1 Packet Object
  * \param MSG_message_t* message : IN - the Message Object that contains an uin32_t array representation of the input string
- * \param uint64_t blockIndex : IN - the block index of the current 512-bit block
- * \param uint8_t* wordIndex : IN - the word index of the words of the current 512-bit block
  */
 static void SHA1_append64bitRepresentationOfLength(SHA1_packet_t* packet,
-												   MSG_message_t* message,
-												   uint64_t blockIndex,
-												   uint8_t* wordIndex);
-
-/**
- * \brief This function expands the 16 words of the current 512-bit block in to 80 words.
- *
- * Check Prof. Jakob's lecture slides on SHA-1 algorithm.
- *
- * \param const uint32_t * message : IN - the pre-processed 512-bit wide input message
- */
-static void SHA1_wordExpansion(const uint32_t * message);
+												   MSG_message_t* message);
 
 /**
  * \brief This function performs ROTL on a uint32_t variable
@@ -164,8 +193,9 @@ static uint32_t SHA1_simpleROTL32(uint32_t uint32Value, uint8_t numOfShiftBits);
  * \param uint32_t inputHashC : IN - input hash C
  * \param uint32_t inputHashD : IN - input hash D
  * \param uint32_t inputHashE : IN - input hash E
+ * \param uint32_t expandedWord : IN - the expanded word of the current round
  */
-static uint32_t SHA1_computeOutputHashA(uint8_t roundIndex, uint32_t inputHashA, uint32_t inputHashB, uint32_t inputHashC, uint32_t inputHashD, uint32_t inputHashE);
+static uint32_t SHA1_computeOutputHashA(uint8_t roundIndex, uint32_t inputHashA, uint32_t inputHashB, uint32_t inputHashC, uint32_t inputHashD, uint32_t inputHashE, uint32_t expandedWord);
 
 /**
  * \brief This function checks if the current stage of the Compression Function is stage 1 or not,
@@ -251,6 +281,59 @@ static uint32_t SHA1_kernelFunctionForStage03(uint32_t x, uint32_t y, uint32_t z
  */
 static uint32_t SHA1_kernelFunctionForStage04(uint32_t x, uint32_t y, uint32_t z);
 
+/**
+ * \brief This function loads the 16 words of a 512-bit block from 64 bytes, in Big Endian.
+ *
+ * If the bytes are 4-byte aligned, whole words are loaded and byte-swapped,
+ * otherwise every byte is loaded on its own (unaligned-safe path).
+ *
+ * \param uint32_t * word : OUT - the 16 words of the 512-bit block
+ * \param const uint8_t * block : IN - 64 bytes of the message, any alignment
+ */
+static void SHA1_loadBigEndianWords(uint32_t * word, const uint8_t * block);
+
+/**
+ * \brief This function compresses 64 bytes of the message and updates the chaining hash words.
+ *
+ * \param uint32_t * hash : IN/OUT - the 5 chaining hash words
+ * \param const uint8_t * block : IN - 64 bytes of the message, any alignment
+ */
+static void SHA1_compressBlockBytes(uint32_t * hash, const uint8_t * block);
+
+/**
+ * \brief This function writes the 8 hex characters of a nonce into the pre-processed tail blocks of a stamp.
+ *
+ * \param uint32_t * word : IN/OUT - the words of the tail blocks, big-endian
+ * \param uint32_t nonceOffset : IN - byte offset of the first nonce character
+ * \param uint32_t nonce : IN - the nonce
+ */
+static void SHA1_powPutNonce(uint32_t * word, uint32_t nonceOffset, uint32_t nonce);
+
+/**
+ * \brief This function searches a range of nonces in order and stops at the first one that meets the target.
+ *
+ * \param const SHA1_powTail_t* tail : IN - the prepared stamp
+ * \param const uint32_t * targetMask : IN - 5 words, bits of the hash that must be 0
+ * \param uint32_t firstNonce : IN - first nonce of the range
+ * \param uint32_t numOfNonces : IN - number of nonces of the range
+ * \param uint32_t* foundOffset : OUT - nonce - firstNonce of the found nonce
+ * \param uint32_t * hash_ptr : OUT - the 5 hash words of the found nonce
+ * \return TRUE if a nonce of the range meets the target
+ */
+static boolean_t SHA1_powSearchRange(const SHA1_powTail_t* tail, const uint32_t * targetMask, uint32_t firstNonce,
+		uint32_t numOfNonces, uint32_t* foundOffset, uint32_t * hash_ptr);
+
+#if !defined(__nios2__)
+/**
+ * \brief One thread of SHA1_powSearchParallel(): takes the next piece of the range until there is none left in
+ * 		  front of the lowest nonce found so far.
+ *
+ * \param void* argument : IN/OUT - the SHA1_powShared_t of the search
+ * \return NULL
+ */
+static void* SHA1_powSearchThread(void* argument);
+#endif
+
 
 /*****************************************************************************/
 /* Function implementation - global ('extern') and local ('static')          */
@@ -267,14 +350,8 @@ static uint32_t SHA1_kernelFunctionForStage04(uint32_t x, uint32_t y, uint32_t z
  */
 void SHA1_init(SHA1_packet_t* packet, MSG_message_t* message)
 {
-	/**
-	 * - Each 512-bit block consists of 16 32-bit words.
-	 * - Theoretically, max number of bits of a message in a single 512-bit block is 447 bit.
-	 * - However the real limit is 440 bit because each ASCII character has 8 bits.
-	 * => If the input string contains more than 55 ASCII characters, we need more 512-bit block(s).
-	 */
 	//calculate how many blocks of 512bit do we need
-	packet->m_numOf512bitBlocks = (message->m_stringLength + (SHA1_MAX_ASCII_CHARS_PER_BLOCK - 1)) / SHA1_MAX_ASCII_CHARS_PER_BLOCK;
+	packet->m_numOf512bitBlocks = SHA1_getNumOf512bitBlocks(message->m_stringLength);
 
 	//allocate memory based on how many 512-bit blocks are needed.
 	packet->m_512bit_block = (SHA1_512bit_block_t*)malloc(packet->m_numOf512bitBlocks * sizeof(SHA1_512bit_block_t));
@@ -285,13 +362,29 @@ void SHA1_init(SHA1_packet_t* packet, MSG_message_t* message)
 	//initialize the output hash words of each 512bit block to 0. They will be modified later.
 	SHA1_initOutputHash(packet);
 
-	//initialize the 16 words of each 512bit block to 0. They will be modified later.
-	SHA1_initWords(packet);
+	//initialize the 16 words of the tail blocks to 0, the full blocks are completely overwritten anyway.
+	SHA1_initWords(packet, message->m_stringLength / SHA1_BLOCK_SIZE_IN_BYTES);
 
 	//Pre-Processing step
 	SHA1_preProcessing(packet, message);
 }
 
+/**
+ * \brief Exact number of 512-bit blocks of a pre-processed message.
+ *
+ * The message, 1 byte with the Padding bit and the 8-byte length field, rounded up to whole 64-byte blocks:
+ * - full blocks:  length / 64, they only hold ASCII characters
+ * - tail blocks:  1 if the remaining (length % 64) characters leave room for the Padding and the length field,
+ *                 i.e. at most 55 characters (SHA1_MAX_ASCII_CHARS_PER_BLOCK), otherwise 2
+ *
+ * \param uint64_t messageLength : IN - length of the original message, in bytes
+ * \return number of 512-bit blocks
+ */
+uint64_t SHA1_getNumOf512bitBlocks(uint64_t messageLength)
+{
+	return ((messageLength + (SHA1_BLOCK_SIZE_IN_BYTES - SHA1_LENGTH_FIELD_OFFSET_IN_BYTES)) / SHA1_BLOCK_SIZE_IN_BYTES) + 1;
+}
+
 /**
  * \brief This function initialize the 5 input hash values of each 512bit block.
  *
@@ -340,14 +433,15 @@ static void SHA1_initOutputHash(SHA1_packet_t* packet)
 }
 
 /**
- * \brief initialize the 16 words of each 512bit block to 0. They will be modified later.
+ * \brief initialize the 16 words of the 512bit blocks from firstBlockIndex on to 0. They will be modified later.
  *
  * \param SHA1_packet_t* packet : IN - the SHA-1 Packet Object
+ * \param uint64_t firstBlockIndex : IN - index of the first block to initialize
  */
-static void SHA1_initWords(SHA1_packet_t* packet)
+static void SHA1_initWords(SHA1_packet_t* packet, uint64_t firstBlockIndex)
 {
-	//initialize the 16 words of each 512bit block to 0. They will be modified later.
-	for(uint64_t blockIndex = 0; blockIndex < packet->m_numOf512bitBlocks; blockIndex++)
+	//initialize the 16 words of each of these 512bit blocks to 0. They will be modified later.
+	for(uint64_t blockIndex = firstBlockIndex; blockIndex < packet->m_numOf512bitBlocks; blockIndex++)
 	{
 		for(uint8_t wordIndex = 0; wordIndex < SHA1_TOTAL_WORDS_PER_BLOCK; wordIndex++)
 		{
@@ -360,214 +454,92 @@ static void SHA1_initWords(SHA1_packet_t* packet)
  * \brief This function perform SHA-1 Pre-Processing step for input messages of arbitrary length.
  *
  * Pre-processing consists of 3 steps:
- * + #Step 1: put ASCII characters into the bits allocated for the Message part of the 512-bit block
- * + #Step 2: add the Padding part to the 512-bit block
- * + #Step 3: append the 64-bit representation of the length of the original message to the 512-bit block.
+ * + #Step 1: put ASCII characters into the bits allocated for the Message part of the 512-bit blocks
+ * + #Step 2: add the Padding part right after the last ASCII character
+ * + #Step 3: append the 64-bit representation of the length of the original message to the last 512-bit block.
  *
- * - In simple case, where the original message length is equal to or less than 55 characters,
- *   those mentioned 3 steps will be performed on a single 512-bit block.
- * - However, if the original message length is larger than 55 characters,
- *   things get more complicated:
- *    + Step 1 is performed in a way that it will fill all characters to the blocks.
- *      If block[0] is out of space, then it will continue to fill in block[1] and so on
- *      until all characters are appended into the blocks.
- *    + Step 2: add the Padding right after finishing appending the ASCII characters in whichever
- *      block that Step 1 stops at.
- *    + Step 3: append the 64-bit representation of the length of the original message
- *      to the final block.
+ * - The message is split into (length / 64) full blocks, which only hold ASCII characters,
+ *   and 1 or 2 tail blocks (see SHA1_getNumOf512bitBlocks()).
+ * - Step 1 copies the full blocks word by word, without any check per block.
+ * - Step 2 and 3 are done once per message and only touch the tail blocks,
+ *   the positions of the Padding and the length field follow from the message length.
  *
  * \param SHA1_packet_t* packet : IN - the SHA-1 Packet Object
  * \param MSG_message_t* message : IN - the Message Object that contains an uin32_t array representation of the input string
  */
 static void SHA1_preProcessing(SHA1_packet_t* packet, MSG_message_t* message)
 {
-	for(uint64_t blockIndex = 0; blockIndex < packet->m_numOf512bitBlocks; blockIndex++)
-	{
-		//### pre-process the original message into the 512-bit block.
+	uint64_t numOfFullBlocks = message->m_stringLength / SHA1_BLOCK_SIZE_IN_BYTES;
 
-		/* The "wordIndex", which indexes the 16 32-bit words of each 512-bit block,
-		 * it will go from 0 to 15 within the 512-bit block. */
-		uint8_t wordIndex = 0;
+	//#Step 1: put ASCII characters into the bits allocated for the Message part of the 512-bit blocks
+	SHA1_putASCIIinto512bitBlock(packet, message, numOfFullBlocks);
 
-		/* - The "uint32ArrayIndex" is another story, it indexes the words/elements in the
-		 *   uint32_t array of the "message" Object.
-		 * - It does not care about the indexes of the 512-bit block and the current word within
-		 *   the 512-bit block.
-		 * - So it is a static variable. */
-		static uint64_t uint32ArrayIndex = 0;
+	//#Step 2: add the Padding part right after the last ASCII character.
+	SHA1_addPaddingInto512bitBlock(packet, message, numOfFullBlocks);
 
-		//#Step 1: put ASCII characters into the bits allocated for the Message part of the 512-bit block
-		SHA1_putASCIIinto512bitBlock(packet, message, blockIndex, &wordIndex, &uint32ArrayIndex);
-
-		//#Step 2: add the Padding part to the 512-bit block.
-		SHA1_addPaddingInto512bitBlock(packet, message, blockIndex, &wordIndex);
-
-		//#Step 3: append the 64-bit representation of the length of the original message.
-		SHA1_append64bitRepresentationOfLength(packet, message, blockIndex, &wordIndex);
-
-	}//end of for(uint64_t blockIndex = 0; blockIndex < packet->m_numOf512bitBlocks; blockIndex++)
+	//#Step 3: append the 64-bit representation of the length of the original message.
+	SHA1_append64bitRepresentationOfLength(packet, message);
 }
 
 /**
- * \brief This function append the ASCII characters into the 512-bit blocks
+ * \brief This function puts the ASCII characters into the 512-bit blocks
  *
- * \param SHA1_packet_t* packet : IN - the SHA-1 Packet Object
+ * The full blocks take 16 words each, the remaining words (less than 16) go into the first tail block.
+ *
+ * \param SHA1_packet_t* packet : IN/OUT - the SHA-1 Packet Object
  * \param MSG_message_t* message : IN - the Message Object that contains an uin32_t array representation of the input string
- * \param uint64_t blockIndex : IN - the block index of the current 512-bit block
- * \param uint8_t* wordIndex : IN - the word index of the words of the current 512-bit block
- * \param uint64_t* uint32ArrayIndex : IN - the index of the uint32_t array of the Message Object
+ * \param uint64_t numOfFullBlocks : IN - number of 512-bit blocks that only hold ASCII characters
  */
 static void SHA1_putASCIIinto512bitBlock(SHA1_packet_t* packet,
 										 MSG_message_t* message,
-										 uint64_t blockIndex,
-										 uint8_t* wordIndex,
-										 uint64_t* uint32ArrayIndex)
+										 uint64_t numOfFullBlocks)
 {
-	//when (*uint32ArrayIndex) has reached its limit, we don't append ASCII characters anymore
-	if((*uint32ArrayIndex) >= message->m_numOfElementsInUint32Array)
-	{
-		//increment the (*wordIndex) to do the next step, which is append padding.
-		(*wordIndex)++;
+	//indexes the words/elements in the uint32_t array of the "message" Object
+	uint64_t uint32ArrayIndex = 0;
 
-		return;
-	}
-
-	//Find the limit of the Uint32_t Array in each iteration (of 512-bit blocks).
-	uint64_t uint32ArrayLimit = 0;
-
-	// '+1' here because "message->m_numOfElementsInUint32Array" starts from '1', while "blockIndex" starts from '0'.
-	if (message->m_numOfElementsInUint32Array <= ((blockIndex + 1) * SHA1_TOTAL_WORDS_PER_BLOCK))
+	//full blocks: 16 words of ASCII characters each
+	for(uint64_t blockIndex = 0; blockIndex < numOfFullBlocks; blockIndex++)
 	{
-		uint32ArrayLimit = message->m_numOfElementsInUint32Array;
-	}
-	else
-	{
-		// '+1' here because "uint32ArrayLimit" starts from '1', while "blockIndex" starts from '0'.
-		uint32ArrayLimit = ((blockIndex + 1) * SHA1_TOTAL_WORDS_PER_BLOCK);
+		for(uint8_t wordIndex = 0; wordIndex < SHA1_TOTAL_WORDS_PER_BLOCK; wordIndex++)
+		{
+			packet->m_512bit_block[blockIndex].m_word[wordIndex] = message->m_uint32Array[uint32ArrayIndex];
+			uint32ArrayIndex++;
+		}
 	}
 
-	//append the ASCII characters into the words of the current 512-bit block.
-	for(; (*uint32ArrayIndex) < uint32ArrayLimit; (*uint32ArrayIndex)++)
+	//first tail block: the remaining words, the last one is already left-aligned by MSG_init()
+	for(uint8_t wordIndex = 0; uint32ArrayIndex < message->m_numOfElementsInUint32Array; wordIndex++)
 	{
-		packet->m_512bit_block[blockIndex].m_word[(*wordIndex)] = message->m_uint32Array[(*uint32ArrayIndex)];
-
-		//increment the (*wordIndex) to do the next step, append padding.
-		(*wordIndex)++;
+		packet->m_512bit_block[numOfFullBlocks].m_word[wordIndex] = message->m_uint32Array[uint32ArrayIndex];
+		uint32ArrayIndex++;
 	}
 }
 
 /**
- * \brief This function appends the padding the 512-bit block.
+ * \brief This function appends the Padding (a single '1' bit) right after the last ASCII character.
  *
- * \param SHA1_packet_t* packet : IN - the SHA-1 Packet Object
+ * \param SHA1_packet_t* packet : IN/OUT - the SHA-1 Packet Object
  * \param MSG_message_t* message : IN - the Message Object that contains an uin32_t array representation of the input string
- * \param uint64_t blockIndex : IN - the block index of the current 512-bit block
- * \param uint8_t* wordIndex : IN - the word index of the words of the current 512-bit block
+ * \param uint64_t numOfFullBlocks : IN - number of 512-bit blocks that only hold ASCII characters
  */
 static void SHA1_addPaddingInto512bitBlock(SHA1_packet_t* packet,
 										   MSG_message_t* message,
-										   uint64_t blockIndex,
-										   uint8_t* wordIndex)
+										   uint64_t numOfFullBlocks)
 {
-	//this flag is used so that the padding can only be done ONCE.
-	static boolean_t paddingFlag = FALSE;
-
-	//if the 512-bit block is already padded then we move on
-	if(TRUE == paddingFlag)
-	{
-		return;
-	}
-
-	//move back 1 index to check if we can append Padding to the empty slots
-	uint32_t startIndex = ((*wordIndex) - 1);
-
-	/**
-	 * e.g.,           0x00000000
-	 *  -> do Padding: 0x80000000
-	 *  --------------------------
-	 *  -> gives:	   0x80000000
-	 */
-	if ((packet->m_512bit_block[blockIndex].m_word[startIndex] & 0xFFFFFFFF) == 0)
-	{
-		packet->m_512bit_block[blockIndex].m_word[startIndex] = packet->m_512bit_block[blockIndex].m_word[startIndex] | 0x80000000;
-
-		//set the flag to TRUE so that this Padding code will never be executed the 2nd time.
-		paddingFlag = TRUE;
-	}
-	/**
-	 * e.g.,           0x61000000
-	 *  -> do Padding: 0x  800000
-	 *  --------------------------
-	 *  -> gives:	   0x61800000
-	 */
-	else if ((packet->m_512bit_block[blockIndex].m_word[startIndex] & 0x00FFFFFF) == 0)
-	{
-		packet->m_512bit_block[blockIndex].m_word[startIndex] = packet->m_512bit_block[blockIndex].m_word[startIndex] | 0x800000;
-
-		//set the flag to TRUE so that this Padding code will never be executed the 2nd time.
-		paddingFlag = TRUE;
-	}
-	/**
-	 * e.g.,           0x61610000
-	 *  -> do Padding: 0x    8000
-	 *  --------------------------
-	 *  -> gives:	   0x61618000
-	 */
-	else if ((packet->m_512bit_block[blockIndex].m_word[startIndex] & 0x0000FFFF) == 0)
-	{
-		packet->m_512bit_block[blockIndex].m_word[startIndex] = packet->m_512bit_block[blockIndex].m_word[startIndex] | 0x8000;
-
-		//set the flag to TRUE so that this Padding code will never be executed the 2nd time.
-		paddingFlag = TRUE;
-	}
-	/**
-	 * e.g.,           0x61616100
-	 *  -> do Padding: 0x      80
-	 *  --------------------------
-	 *  -> gives:	   0x61616180
-	 */
-	else if ((packet->m_512bit_block[blockIndex].m_word[startIndex] & 0x000000FF) == 0)
-	{
-		packet->m_512bit_block[blockIndex].m_word[startIndex] = packet->m_512bit_block[blockIndex].m_word[startIndex] | 0x80;
+	//position of the first byte after the message within the first tail block, always < 64
+	uint8_t paddingByteIndex = (uint8_t)(message->m_stringLength % SHA1_BLOCK_SIZE_IN_BYTES);
 
-		//set the flag to TRUE so that this Padding code will never be executed the 2nd time.
-		paddingFlag = TRUE;
-	}
 	/**
-	 * e.g.,           0x61616161 ???
-	 *  -> we don't do Padding immediately, we increment the start index to the next word,
-	 *     which will have value    0x00000000
-	 *  -> then do the padding with 0x80000000
-	 *  -> So we will have:
-	 *
-	 *     startIndex   ->	word[0] = 0x61616161
-	 *     startIndex++ ->	word[1] = 0x00000000
-	 *     do Padding:                0x80000000
-	 *     --------------------------------------
-	 *     gives:			word[1] = 0x80000000
+	 * The words are Big Endian, so byte 0 of a word is its most significant byte, e.g.
+	 *   0 characters in the word: 0x80000000
+	 *   1 character  in the word: 0x61800000
+	 *   2 characters in the word: 0x61618000
+	 *   3 characters in the word: 0x61616180
 	 */
-	else
-	{
-		//we don't do Padding immediately, we increment the start index to the next word
-		startIndex++;
-
-		/**
-		 * #special case: start index has exceeded its limit,
-		 *  which means the current 512-bit block has run out of words for us to
-		 *  append the Padding.
-		 *  => we end our function here, then in the next iteration, startIndex will start from 0
-		 */
-		if(startIndex == SHA1_TOTAL_WORDS_PER_BLOCK)
-		{
-			return;
-		}
-
-		//do the padding with 0x80000000 as mentioned above
-		packet->m_512bit_block[blockIndex].m_word[startIndex] = packet->m_512bit_block[blockIndex].m_word[startIndex] | 0x80000000;
+	uint8_t wordIndex = paddingByteIndex / 4;
+	uint8_t shift = (uint8_t)(24 - (8 * (paddingByteIndex % 4)));
 
-		//set the flag to TRUE so that this Padding code will never be executed the 2nd time.
-		paddingFlag = TRUE;
-	}
+	packet->m_512bit_block[numOfFullBlocks].m_word[wordIndex] |= ((uint32_t)0x80 << shift);
 }
 
 /**
@@ -576,25 +548,15 @@ static void SHA1_addPaddingInto512bitBlock(SHA1_packet_t* packet,
  * How this algorithm works is that we just put the last 64-bit representation
  * of the original message length to the last 64-bit of the last 512-bit block
  *
- * \param SHA1_packet_t* packet : IN - the SHA-1 Packet Object
+ * \param SHA1_packet_t* packet : IN/OUT - the SHA-1 Packet Object
  * \param MSG_message_t* message : IN - the Message Object that contains an uin32_t array representation of the input string
- * \param uint64_t blockIndex : IN - the block index of the current 512-bit block
- * \param uint8_t* wordIndex : IN - the word index of the words of the current 512-bit block
  */
 static void SHA1_append64bitRepresentationOfLength(SHA1_packet_t* packet,
-												   MSG_message_t* message,
-												   uint64_t blockIndex,
-												   uint8_t* wordIndex)
+												   MSG_message_t* message)
 {
 	//find the index of the last 512-bit block
 	uint64_t lastBlockIndex = packet->m_numOf512bitBlocks - 1;
 
-	//if this block index is not the index of the last 512-bit block => we bypass this function
-	if(blockIndex < lastBlockIndex)
-	{
-		return;
-	}
-
 	//calculate number of bits of the original messgage
 	uint64_t messageLengthInBits = ( (message->m_stringLength) * 8 );
 
@@ -632,12 +594,13 @@ void SHA1_printPreProcessedPacket(SHA1_packet_t* packet)
 {
 	alt_putstr("\n## Printing the pre-processed blocks of 512-bit wide input message of the SHA-1 packet ##\n");
 
-	alt_printf("Number of pre-processed Blocks: %x (in hex)\n", packet->m_numOf512bitBlocks);
+	//%x takes a 32-bit argument, a uint64_t would shift all following arguments
+	alt_printf("Number of pre-processed Blocks: %x (in hex)\n", (uint32_t)packet->m_numOf512bitBlocks);
 
 	alt_putstr("block indexes are in hex!\n");
 	for(uint64_t blockIndex = 0; blockIndex < packet->m_numOf512bitBlocks; blockIndex++)
 	{
-		alt_printf("- Block[%x]:\n", blockIndex);
+		alt_printf("- Block[%x]:\n", (uint32_t)blockIndex);
 		for(uint8_t wordIndex = 0; wordIndex < SHA1_TOTAL_WORDS_PER_BLOCK; wordIndex++)
 		{
 			//this API is quite strange.. I cannot print the index, if I do, things will mess up!
@@ -654,14 +617,52 @@ void SHA1_printPreProcessedPacket(SHA1_packet_t* packet)
  * This function is required in the Lab Assignment#1.
  * Check Prof. Jakob's lecture slides on the SHA-1 algorithm.
  *
+ * The implementation of the Compression Function is selected in "sha1_config.h".
+ *
  * \param uint32_t * hash_ptr : OUT - pointer to the processed hash
  * \param const uint32_t * message : IN - the pre-processed 512-bit wide input message
  * \param const uint32_t * prev_hash : IN - pointer to the initial hash
  */
 void sha_1(uint32_t * hash_ptr, const uint32_t * message, const uint32_t * prev_hash)
 {
+#if (SHA1_CONFIG_COMPRESSION == SHA1_COMPRESSION_UNROLLED)
+	SHA1_compressUnrolled(hash_ptr, message, prev_hash);
+#elif (SHA1_CONFIG_COMPRESSION == SHA1_COMPRESSION_STAGE_DISPATCH)
+	SHA1_compressStageDispatch(hash_ptr, message, prev_hash);
+#elif (SHA1_CONFIG_COMPRESSION == SHA1_COMPRESSION_X86_SHA_NI)
+	SHA1_niCompressDispatch(hash_ptr, message, prev_hash);
+#elif (SHA1_CONFIG_COMPRESSION == SHA1_COMPRESSION_AVALON_ACCEL)
+#if !defined(SHA1_ACCEL)
+#error "SHA1_COMPRESSION_AVALON_ACCEL needs the SHA-1 accelerator in base_sys.qsys, SHA1_ACCEL_BASE is missing in system.h"
+#endif
+	SHA1_accelCompress(hash_ptr, message, prev_hash);
+#elif (SHA1_CONFIG_COMPRESSION == SHA1_COMPRESSION_NIOS_CUSTOM_INSTR)
+#if defined(__nios2__) && !defined(SHA1_CI)
+#error "SHA1_COMPRESSION_NIOS_CUSTOM_INSTR needs the SHA-1 custom instruction in base_sys.qsys, ALT_CI_SHA1_CI_N is missing in system.h"
+#endif
+	SHA1_compressCustomInstr(hash_ptr, message, prev_hash);
+#else
+#error "SHA1_CONFIG_COMPRESSION has an unknown value, check sha1_config.h"
+#endif
+}
+
+/**
+ * \brief Compression Function with per-round stage dispatch.
+ *
+ * Each of the 80 rounds checks which stage it belongs to and calls the matching kernel function.
+ * This is the original implementation of sha_1(), kept as reference for the other implementations.
+ *
+ * \param uint32_t * hash_ptr : OUT - pointer to the processed hash
+ * \param const uint32_t * message : IN - the pre-processed 512-bit wide input message
+ * \param const uint32_t * prev_hash : IN - pointer to the initial hash
+ */
+void SHA1_compressStageDispatch(uint32_t * hash_ptr, const uint32_t * message, const uint32_t * prev_hash)
+{
+	//array of 80 expanded words to be processed in the Compression Function, owned by this call
+	uint32_t expandedWord[SHA1_NUM_OF_EXPANDED_WORDS_PER_BLOCK];
+
 	//Perform expansion of the 16 words in to 80 words to be processed in the Compression Function
-	SHA1_wordExpansion(message);
+	SHA1_wordExpansion(message, expandedWord);
 
 	//Buffer for the prev_hash, this buffer will be modified in the 80 rounds.
 	uint32_t inputHash[SHA1_NUM_OF_HASH_WORDS_PER_BLOCK] = {0};
@@ -701,7 +702,8 @@ void sha_1(uint32_t * hash_ptr, const uint32_t * message, const uint32_t * prev_
 														inputHash[SHA1_HASH_B],
 														inputHash[SHA1_HASH_C],
 														inputHash[SHA1_HASH_D],
-														inputHash[SHA1_HASH_E]);
+														inputHash[SHA1_HASH_E],
+														expandedWord[roundIndex]);
 
 		//Hash B computation
 		hash_ptr[SHA1_HASH_B] = inputHash[SHA1_HASH_A];
@@ -781,37 +783,206 @@ void sha_1(uint32_t * hash_ptr, const uint32_t * message, const uint32_t * prev_
 	hash_ptr[SHA1_HASH_E] += prev_hash[SHA1_HASH_E];
 }
 
+/**
+ * \brief Compression Function with the 4 stages x 20 rounds fully unrolled.
+ *
+ * The 5 hash words are rotated between the rounds by renaming instead of copying,
+ * so there are no range checks, no kernel function calls and no array copies.
+ * Runs the message schedule selected by SHA1_CONFIG_SCHEDULE, the other one stays callable for the benchmark.
+ * hash_ptr may point to the same array as prev_hash.
+ *
+ * \param uint32_t * hash_ptr : OUT - pointer to the processed hash
+ * \param const uint32_t * message : IN - the pre-processed 512-bit wide input message
+ * \param const uint32_t * prev_hash : IN - pointer to the initial hash
+ */
+void SHA1_compressUnrolled(uint32_t * hash_ptr, const uint32_t * message, const uint32_t * prev_hash)
+{
+#if (SHA1_CONFIG_SCHEDULE == SHA1_SCHEDULE_ROLLING_16)
+	SHA1_compressUnrolledRolling16(hash_ptr, message, prev_hash);
+#elif (SHA1_CONFIG_SCHEDULE == SHA1_SCHEDULE_EXPANDED_80)
+	SHA1_compressUnrolledExpanded80(hash_ptr, message, prev_hash);
+#else
+#error "SHA1_CONFIG_SCHEDULE has an unknown value, check sha1_config.h"
+#endif
+}
+
+/**
+ * \brief SHA1_compressUnrolled() with the message schedule SHA1_SCHEDULE_EXPANDED_80.
+ *
+ * All 80 words are expanded into an 80-word buffer on the stack before the first round.
+ * hash_ptr may point to the same array as prev_hash.
+ *
+ * \param uint32_t * hash_ptr : OUT - pointer to the processed hash
+ * \param const uint32_t * message : IN - the pre-processed 512-bit wide input message
+ * \param const uint32_t * prev_hash : IN - pointer to the initial hash
+ */
+void SHA1_compressUnrolledExpanded80(uint32_t * hash_ptr, const uint32_t * message, const uint32_t * prev_hash)
+{
+	//array of 80 expanded words to be processed in the Compression Function, owned by this call
+	uint32_t expandedWord[SHA1_NUM_OF_EXPANDED_WORDS_PER_BLOCK];
+
+	//Perform expansion of the 16 words in to 80 words to be processed in the Compression Function
+	SHA1_wordExpansion(message, expandedWord);
+
+#define W(roundIndex)	expandedWord[(roundIndex)]
+
+	//the 5 hash words live in local variables for the whole block
+	uint32_t a = prev_hash[SHA1_HASH_A];
+	uint32_t b = prev_hash[SHA1_HASH_B];
+	uint32_t c = prev_hash[SHA1_HASH_C];
+	uint32_t d = prev_hash[SHA1_HASH_D];
+	uint32_t e = prev_hash[SHA1_HASH_E];
+
+	SHA1_UNROLLED_EIGHTY_ROUNDS();
+
+#undef W
+
+	//compute final hash values for current 512-bit block
+	hash_ptr[SHA1_HASH_A] = prev_hash[SHA1_HASH_A] + a;
+	hash_ptr[SHA1_HASH_B] = prev_hash[SHA1_HASH_B] + b;
+	hash_ptr[SHA1_HASH_C] = prev_hash[SHA1_HASH_C] + c;
+	hash_ptr[SHA1_HASH_D] = prev_hash[SHA1_HASH_D] + d;
+	hash_ptr[SHA1_HASH_E] = prev_hash[SHA1_HASH_E] + e;
+}
+
+/**
+ * \brief SHA1_compressUnrolled() with the message schedule SHA1_SCHEDULE_ROLLING_16.
+ *
+ * W[t] is computed inside the rounds, in a 16-word circular buffer.
+ * hash_ptr may point to the same array as prev_hash.
+ *
+ * \param uint32_t * hash_ptr : OUT - pointer to the processed hash
+ * \param const uint32_t * message : IN - the pre-processed 512-bit wide input message
+ * \param const uint32_t * prev_hash : IN - pointer to the initial hash
+ */
+void SHA1_compressUnrolledRolling16(uint32_t * hash_ptr, const uint32_t * message, const uint32_t * prev_hash)
+{
+	//16-word circular buffer, word t of the schedule is stored at index (t % 16)
+	uint32_t w[SHA1_TOTAL_WORDS_PER_BLOCK];
+
+	//The 512 bit wide input message is mapped on the first 16 words
+	for(uint8_t wordIndex = 0; wordIndex < SHA1_TOTAL_WORDS_PER_BLOCK; wordIndex++)
+	{
+		w[wordIndex] = message[wordIndex];
+	}
+
+	//from 16 to 79, W[t] replaces W[t - 16] in the circular buffer right before round t uses it
+#define W(roundIndex)	SHA1_ROLLING_WORD(w, roundIndex)
+
+	//the 5 hash words live in local variables for the whole block
+	uint32_t a = prev_hash[SHA1_HASH_A];
+	uint32_t b = prev_hash[SHA1_HASH_B];
+	uint32_t c = prev_hash[SHA1_HASH_C];
+	uint32_t d = prev_hash[SHA1_HASH_D];
+	uint32_t e = prev_hash[SHA1_HASH_E];
+
+	SHA1_UNROLLED_EIGHTY_ROUNDS();
+
+#undef W
+
+	//compute final hash values for current 512-bit block
+	hash_ptr[SHA1_HASH_A] = prev_hash[SHA1_HASH_A] + a;
+	hash_ptr[SHA1_HASH_B] = prev_hash[SHA1_HASH_B] + b;
+	hash_ptr[SHA1_HASH_C] = prev_hash[SHA1_HASH_C] + c;
+	hash_ptr[SHA1_HASH_D] = prev_hash[SHA1_HASH_D] + d;
+	hash_ptr[SHA1_HASH_E] = prev_hash[SHA1_HASH_E] + e;
+}
+
+/**
+ * \brief Compression Function on the SHA-1 round step custom instruction of the Nios II, see "sha1_ci.h".
+ *
+ * The instruction keeps the 5 hash words, the CPU loads them, then gives it W[t] of each round from the 16-word
+ * circular buffer, and reads the final hash words with prev_hash already added. Without the instruction (on the
+ * host) the same instructions go to its C model SHA1_ciModel().
+ * hash_ptr may point to the same array as prev_hash.
+ *
+ * \param uint32_t * hash_ptr : OUT - pointer to the processed hash
+ * \param const uint32_t * message : IN - the pre-processed 512-bit wide input message
+ * \param const uint32_t * prev_hash : IN - pointer to the initial hash
+ */
+void SHA1_compressCustomInstr(uint32_t * hash_ptr, const uint32_t * message, const uint32_t * prev_hash)
+{
+	//16-word circular buffer, word t of the schedule is stored at index (t % 16)
+	uint32_t w[SHA1_TOTAL_WORDS_PER_BLOCK];
+
+	//The 512 bit wide input message is mapped on the first 16 words
+	for(uint8_t wordIndex = 0; wordIndex < SHA1_TOTAL_WORDS_PER_BLOCK; wordIndex++)
+	{
+		w[wordIndex] = message[wordIndex];
+	}
+
+#define W(roundIndex)	SHA1_ROLLING_WORD(w, roundIndex)
+
+	SHA1_CI_WRITE(SHA1_CI_OP_LOAD_AB, prev_hash[SHA1_HASH_A], prev_hash[SHA1_HASH_B]);
+	SHA1_CI_WRITE(SHA1_CI_OP_LOAD_CD, prev_hash[SHA1_HASH_C], prev_hash[SHA1_HASH_D]);
+	SHA1_CI_WRITE(SHA1_CI_OP_LOAD_E, prev_hash[SHA1_HASH_E], 0);
+
+	//stage 1: rounds 0 .. 19
+	SHA1_CI_FIVE_ROUNDS(SHA1_CI_OP_ROUND_STAGE_1, 0);
+	SHA1_CI_FIVE_ROUNDS(SHA1_CI_OP_ROUND_STAGE_1, 5);
+	SHA1_CI_FIVE_ROUNDS(SHA1_CI_OP_ROUND_STAGE_1, 10);
+	SHA1_CI_FIVE_ROUNDS(SHA1_CI_OP_ROUND_STAGE_1, 15);
+
+	//stage 2: rounds 20 .. 39
+	SHA1_CI_FIVE_ROUNDS(SHA1_CI_OP_ROUND_STAGE_2, 20);
+	SHA1_CI_FIVE_ROUNDS(SHA1_CI_OP_ROUND_STAGE_2, 25);
+	SHA1_CI_FIVE_ROUNDS(SHA1_CI_OP_ROUND_STAGE_2, 30);
+	SHA1_CI_FIVE_ROUNDS(SHA1_CI_OP_ROUND_STAGE_2, 35);
+
+	//stage 3: rounds 40 .. 59
+	SHA1_CI_FIVE_ROUNDS(SHA1_CI_OP_ROUND_STAGE_3, 40);
+	SHA1_CI_FIVE_ROUNDS(SHA1_CI_OP_ROUND_STAGE_3, 45);
+	SHA1_CI_FIVE_ROUNDS(SHA1_CI_OP_ROUND_STAGE_3, 50);
+	SHA1_CI_FIVE_ROUNDS(SHA1_CI_OP_ROUND_STAGE_3, 55);
+
+	//stage 4: rounds 60 .. 79
+	SHA1_CI_FIVE_ROUNDS(SHA1_CI_OP_ROUND_STAGE_4, 60);
+	SHA1_CI_FIVE_ROUNDS(SHA1_CI_OP_ROUND_STAGE_4, 65);
+	SHA1_CI_FIVE_ROUNDS(SHA1_CI_OP_ROUND_STAGE_4, 70);
+	SHA1_CI_FIVE_ROUNDS(SHA1_CI_OP_ROUND_STAGE_4, 75);
+
+#undef W
+
+	//compute final hash values for current 512-bit block, each prev_hash word is read before its hash_ptr word is written
+	hash_ptr[SHA1_HASH_A] = SHA1_CI_READ(SHA1_CI_OP_ADD, SHA1_HASH_A, prev_hash[SHA1_HASH_A]);
+	hash_ptr[SHA1_HASH_B] = SHA1_CI_READ(SHA1_CI_OP_ADD, SHA1_HASH_B, prev_hash[SHA1_HASH_B]);
+	hash_ptr[SHA1_HASH_C] = SHA1_CI_READ(SHA1_CI_OP_ADD, SHA1_HASH_C, prev_hash[SHA1_HASH_C]);
+	hash_ptr[SHA1_HASH_D] = SHA1_CI_READ(SHA1_CI_OP_ADD, SHA1_HASH_D, prev_hash[SHA1_HASH_D]);
+	hash_ptr[SHA1_HASH_E] = SHA1_CI_READ(SHA1_CI_OP_ADD, SHA1_HASH_E, prev_hash[SHA1_HASH_E]);
+}
+
 /**
  * \brief This function expands the 16 words of the current 512-bit block in to 80 words.
  *
  * Check Prof. Jakob's lecture slides on SHA-1 algorithm.
  *
  * \param const uint32_t * message : IN - the pre-processed 512-bit wide input message
+ * \param uint32_t * expandedWord : OUT - array of 80 expanded words, owned by the caller
  */
-static void SHA1_wordExpansion(const uint32_t * message)
+void SHA1_wordExpansion(const uint32_t * message, uint32_t * expandedWord)
 {
 	uint16_t expandedWordIndex = 0;
 
 	//The 512 bit wide input message is mapped on the first 16 words
 	for(; expandedWordIndex < SHA1_TOTAL_WORDS_PER_BLOCK; expandedWordIndex++)
 	{
-		SHA1_expanded_word[expandedWordIndex] = message[expandedWordIndex];
+		expandedWord[expandedWordIndex] = message[expandedWordIndex];
 	}
 
 	//from 16 to 79 is another story
 	for(; expandedWordIndex < SHA1_NUM_OF_EXPANDED_WORDS_PER_BLOCK; expandedWordIndex++)
 	{
 		//save the indexes from earlier operation
-		uint32_t wordIndexMinus3  = SHA1_expanded_word[expandedWordIndex - 3];
-		uint32_t wordIndexMinus8  = SHA1_expanded_word[expandedWordIndex - 8];
-		uint32_t wordIndexMinus14 = SHA1_expanded_word[expandedWordIndex - 14];
-		uint32_t wordIndexMinus16 = SHA1_expanded_word[expandedWordIndex - 16];
+		uint32_t wordIndexMinus3  = expandedWord[expandedWordIndex - 3];
+		uint32_t wordIndexMinus8  = expandedWord[expandedWordIndex - 8];
+		uint32_t wordIndexMinus14 = expandedWord[expandedWordIndex - 14];
+		uint32_t wordIndexMinus16 = expandedWord[expandedWordIndex - 16];
 
 		//XOR result of the 4 earlier words
 		uint32_t xorOperationResult = wordIndexMinus3 ^ wordIndexMinus8 ^ wordIndexMinus14 ^ wordIndexMinus16;
 
 		//Perform ROTL by 1 bit on the XOR result
-		SHA1_expanded_word[expandedWordIndex] = SHA1_simpleROTL32(xorOperationResult, 1);
+		expandedWord[expandedWordIndex] = SHA1_simpleROTL32(xorOperationResult, 1);
 	}
 
 #if SHA1_CONFIG_ENABLE_DEBUG
@@ -825,7 +996,7 @@ static void SHA1_wordExpansion(const uint32_t * message)
 	for(uint8_t i = 0; i < SHA1_NUM_OF_EXPANDED_WORDS_PER_BLOCK; i++)
 	{
 		//this API is quite strange.. I cannot print the index, if I do, things will mess up!
-		alt_printf("  + expanded word[] = 0x%x \n", SHA1_expanded_word[i]);
+		alt_printf("  + expanded word[] = 0x%x \n", expandedWord[i]);
 	}
 
 	blockIndex++;
@@ -864,13 +1035,15 @@ static uint32_t SHA1_simpleROTL32(uint32_t uint32Value, uint8_t numOfShiftBits)
  * \param uint32_t inputHashC : IN - input hash C
  * \param uint32_t inputHashD : IN - input hash D
  * \param uint32_t inputHashE : IN - input hash E
+ * \param uint32_t expandedWord : IN - the expanded word of the current round
  */
 static uint32_t SHA1_computeOutputHashA(uint8_t roundIndex,
 										uint32_t inputHashA,
 										uint32_t inputHashB,
 										uint32_t inputHashC,
 										uint32_t inputHashD,
-										uint32_t inputHashE)
+										uint32_t inputHashE,
+										uint32_t expandedWord)
 {
 	//result of the kernel function that is performed on hash B, hash C, and hash D
 	uint32_t processInputHashBCD = 0;
@@ -911,7 +1084,7 @@ static uint32_t SHA1_computeOutputHashA(uint8_t roundIndex,
 	//process input hash A by using ROTL by 5 bits, check Prof. Jakob's slides for explanation of the number '5'
 	uint32_t processInputHashA = SHA1_simpleROTL32(inputHashA, 5);
 
-	return processInputHashA + processInputHashBCD + inputHashE + SHA1_expanded_word[roundIndex] + constantK;
+	return processInputHashA + processInputHashBCD + inputHashE + expandedWord + constantK;
 }
 
 /**
@@ -1067,3 +1240,575 @@ void SHA1_updateInputHashForNextBlock(SHA1_packet_t* packet, uint64_t blockIndex
 	packet->m_512bit_block[nextBlockIndex].m_inputHash[SHA1_HASH_D] = packet->m_512bit_block[blockIndex].m_outputHash[SHA1_HASH_D];
 	packet->m_512bit_block[nextBlockIndex].m_inputHash[SHA1_HASH_E] = packet->m_512bit_block[blockIndex].m_outputHash[SHA1_HASH_E];
 }
+
+/**
+ * \brief Run the Compression Function over all 512-bit blocks of the SHA-1 packet, in order.
+ *
+ * Each block starts from the output hash of the previous one, the final hash is the output hash of the last block.
+ * With SHA1_COMPRESSION_AVALON_ACCEL the accelerator keeps the chaining value itself: only the blocks are written,
+ * and only the output hash of the last block is filled in.
+ *
+ * \param SHA1_packet_t* packet : IN/OUT - the pre-processed SHA-1 Packet Object
+ */
+void SHA1_processPacket(SHA1_packet_t* packet)
+{
+#if (SHA1_CONFIG_COMPRESSION == SHA1_COMPRESSION_AVALON_ACCEL)
+	uint64_t lastBlockIndex = packet->m_numOf512bitBlocks - 1;
+
+	//the first block starts from the magic numbers, the same as m_inputHash of block 0
+	SHA1_accelNewMessage();
+
+	//no read-back of the output hash and no write of the input hash per block.
+	//The next block goes to the other bank while this one is hashed, the core never waits for the CPU:
+	//with ROUNDS_PER_CYCLE 1 the 16 writes take less time than the 80 clock cycles of a block
+	for(uint64_t i = 0; i < packet->m_numOf512bitBlocks; i++)
+	{
+		SHA1_accelChainBlock(packet->m_512bit_block[i].m_word);
+	}
+
+	SHA1_accelGetDigest(packet->m_512bit_block[lastBlockIndex].m_outputHash);
+#else
+	for(uint64_t i = 0; i < packet->m_numOf512bitBlocks; i++)
+	{
+		//operate on a single pre-processed 512-bit wide input message
+		sha_1(packet->m_512bit_block[i].m_outputHash,
+				packet->m_512bit_block[i].m_word,
+				packet->m_512bit_block[i].m_inputHash);
+
+		//takes the output hash of the current 512-bit block and assigns to the input hash of the next 512-bit block
+		SHA1_updateInputHashForNextBlock(packet, i);
+	}
+#endif
+}
+
+/**
+ * \brief Initialization of the streaming SHA-1 context.
+ *
+ * The chaining hash words are set to the magic numbers (FIPS PUB 180-1),
+ * the partial block buffer and the bit counter are cleared.
+ *
+ * \param SHA1_ctx_t* ctx : OUT - the streaming SHA-1 context
+ */
+void SHA1_ctxInit(SHA1_ctx_t* ctx)
+{
+	//apply magic numbers (FIPS PUB 180-1), same as the first 512-bit block of a SHA-1 packet
+	ctx->m_hash[SHA1_HASH_A] = SHA1_INIT_HASH_A;
+	ctx->m_hash[SHA1_HASH_B] = SHA1_INIT_HASH_B;
+	ctx->m_hash[SHA1_HASH_C] = SHA1_INIT_HASH_C;
+	ctx->m_hash[SHA1_HASH_D] = SHA1_INIT_HASH_D;
+	ctx->m_hash[SHA1_HASH_E] = SHA1_INIT_HASH_E;
+
+	ctx->m_bufferLength = 0;
+	ctx->m_messageLengthInBits = 0;
+}
+
+/**
+ * \brief Feed the next part of the message into the streaming SHA-1 context.
+ *
+ * Each time the partial block buffer is full, the 512-bit block is compressed immediately,
+ * so the function can be called any number of times with pieces of any length.
+ * Whole 512-bit blocks are compressed straight from the caller's buffer, only the
+ * leftover bytes are copied into the partial block buffer.
+ *
+ * \param SHA1_ctx_t* ctx : IN/OUT - the streaming SHA-1 context
+ * \param const void* data : IN - the next bytes of the message, any alignment, may contain '\0'
+ * \param uint64_t length : IN - number of bytes in data
+ */
+void SHA1_ctxUpdate(SHA1_ctx_t* ctx, const void* data, uint64_t length)
+{
+	const uint8_t* bytes = (const uint8_t*)data;
+
+	//the bit counter wraps modulo 2^64, as specified in FIPS PUB 180-1
+	ctx->m_messageLengthInBits += length * 8;
+
+	//first complete the partial block left over from the previous call
+	while((ctx->m_bufferLength != 0) && (length > 0))
+	{
+		ctx->m_buffer[ctx->m_bufferLength] = *bytes;
+		ctx->m_bufferLength++;
+		bytes++;
+		length--;
+
+		//the 512-bit block is full => compress it right away
+		if(ctx->m_bufferLength == SHA1_BLOCK_SIZE_IN_BYTES)
+		{
+			SHA1_compressBlockBytes(ctx->m_hash, ctx->m_buffer);
+			ctx->m_bufferLength = 0;
+		}
+	}
+
+	//whole 512-bit blocks are compressed without copying them
+	while(length >= SHA1_BLOCK_SIZE_IN_BYTES)
+	{
+		SHA1_compressBlockBytes(ctx->m_hash, bytes);
+		bytes += SHA1_BLOCK_SIZE_IN_BYTES;
+		length -= SHA1_BLOCK_SIZE_IN_BYTES;
+	}
+
+	//keep the rest for the next call (or for SHA1_ctxFinal())
+	while(length > 0)
+	{
+		ctx->m_buffer[ctx->m_bufferLength] = *bytes;
+		ctx->m_bufferLength++;
+		bytes++;
+		length--;
+	}
+}
+
+/**
+ * \brief Finish the streaming SHA-1 computation.
+ *
+ * The Padding and the 64-bit representation of the message length are added to the
+ * partial block (or to one extra block if there is no space left) and compressed.
+ *
+ * \param SHA1_ctx_t* ctx : IN/OUT - the streaming SHA-1 context
+ * \param uint32_t * hash_ptr : OUT - the 5 final hash words
+ */
+void SHA1_ctxFinal(SHA1_ctx_t* ctx, uint32_t * hash_ptr)
+{
+	//#Step 2 of the Pre-Processing: add the Padding right after the last byte of the message
+	ctx->m_buffer[ctx->m_bufferLength] = 0x80;
+	ctx->m_bufferLength++;
+
+	//no space left for the 64-bit length => fill this block with zeros and use one more block
+	if(ctx->m_bufferLength > SHA1_LENGTH_FIELD_OFFSET_IN_BYTES)
+	{
+		while(ctx->m_bufferLength < SHA1_BLOCK_SIZE_IN_BYTES)
+		{
+			ctx->m_buffer[ctx->m_bufferLength] = 0;
+			ctx->m_bufferLength++;
+		}
+
+		SHA1_compressBlockBytes(ctx->m_hash, ctx->m_buffer);
+		ctx->m_bufferLength = 0;
+	}
+
+	while(ctx->m_bufferLength < SHA1_LENGTH_FIELD_OFFSET_IN_BYTES)
+	{
+		ctx->m_buffer[ctx->m_bufferLength] = 0;
+		ctx->m_bufferLength++;
+	}
+
+	//#Step 3 of the Pre-Processing: append the 64-bit representation of the message length (Big Endian)
+	for(uint8_t byteIndex = 0; byteIndex < 8; byteIndex++)
+	{
+		ctx->m_buffer[SHA1_LENGTH_FIELD_OFFSET_IN_BYTES + byteIndex] = (uint8_t)(ctx->m_messageLengthInBits >> (56 - (8 * byteIndex)));
+	}
+
+	SHA1_compressBlockBytes(ctx->m_hash, ctx->m_buffer);
+	ctx->m_bufferLength = 0;
+
+	hash_ptr[SHA1_HASH_A] = ctx->m_hash[SHA1_HASH_A];
+	hash_ptr[SHA1_HASH_B] = ctx->m_hash[SHA1_HASH_B];
+	hash_ptr[SHA1_HASH_C] = ctx->m_hash[SHA1_HASH_C];
+	hash_ptr[SHA1_HASH_D] = ctx->m_hash[SHA1_HASH_D];
+	hash_ptr[SHA1_HASH_E] = ctx->m_hash[SHA1_HASH_E];
+}
+
+/**
+ * \brief Hash a whole message that is already in memory, in one call.
+ *
+ * The 512-bit blocks are loaded straight from the caller's buffer, no heap memory is used
+ * and the data is not copied, except for the last partial block that needs the Padding.
+ *
+ * \param uint32_t * hash_ptr : OUT - the 5 final hash words
+ * \param const void* data : IN - the message, any alignment, may contain '\0'
+ * \param uint64_t length : IN - number of bytes in data
+ */
+void SHA1_hashBuffer(uint32_t * hash_ptr, const void* data, uint64_t length)
+{
+#if (SHA1_CONFIG_COMPRESSION == SHA1_COMPRESSION_AVALON_ACCEL)
+	//the accelerator does the Padding itself, see "sha1_accel.h".
+	//Its DMA master reads whole words, other buffers are written to it by the CPU.
+	if((((size_t)data & 3) == 0) && (length <= 0xFFFFFFFFu))
+	{
+		SHA1_accelDmaStart(data, (uint32_t)length);
+		SHA1_accelDmaWait(hash_ptr);
+	}
+	else
+	{
+		SHA1_accelHashBuffer(hash_ptr, data, length);
+	}
+#else
+	SHA1_ctx_t ctx;
+
+	SHA1_ctxInit(&ctx);
+	SHA1_ctxUpdate(&ctx, data, length);
+	SHA1_ctxFinal(&ctx, hash_ptr);
+#endif
+}
+
+/**
+ * \brief The 8 hex characters of a nonce, as they are appended to the prefix of a stamp.
+ *
+ * \param char* nonceChars : OUT - SHA1_POW_NONCE_LENGTH lowercase hex characters, not terminated
+ * \param uint32_t nonce : IN - the nonce
+ */
+void SHA1_powFormatNonce(char* nonceChars, uint32_t nonce)
+{
+	static const char hexDigit[16] = {'0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'a', 'b', 'c', 'd', 'e', 'f'};
+
+	//most significant digit first
+	for(uint8_t charIndex = 0; charIndex < SHA1_POW_NONCE_LENGTH; charIndex++)
+	{
+		nonceChars[charIndex] = hexDigit[(nonce >> (28 - (4 * charIndex))) & 0xFu];
+	}
+}
+
+/**
+ * \brief Target mask of a hash with at least numOfZeroBits leading zero bits, the difficulty of a hashcash stamp.
+ *
+ * \param uint32_t * targetMask : OUT - 5 words, the leading numOfZeroBits bits set, word 0 = hash word A
+ * \param uint32_t numOfZeroBits : IN - 0..160
+ */
+void SHA1_powTargetMask(uint32_t * targetMask, uint32_t numOfZeroBits)
+{
+	for(uint8_t hashIndex = 0; hashIndex < SHA1_NUM_OF_HASH_WORDS_PER_BLOCK; hashIndex++)
+	{
+		uint32_t firstBit = 32 * hashIndex;
+
+		if(numOfZeroBits >= (firstBit + 32))
+		{
+			targetMask[hashIndex] = 0xFFFFFFFFu;
+		}
+		else if(numOfZeroBits > firstBit)
+		{
+			targetMask[hashIndex] = 0xFFFFFFFFu << (32 - (numOfZeroBits - firstBit));
+		}
+		else
+		{
+			targetMask[hashIndex] = 0;
+		}
+	}
+}
+
+/**
+ * \brief Hash the full blocks of the prefix into the midstate and pre-process the tail blocks of a stamp.
+ *
+ * \param SHA1_powTail_t* tail : OUT - midstate, tail blocks and offset of the nonce characters
+ * \param const void* prefix : IN - the fixed part of the stamp, any alignment
+ * \param uint32_t prefixLength : IN - number of bytes in prefix
+ */
+void SHA1_powPrepare(SHA1_powTail_t* tail, const void* prefix, uint32_t prefixLength)
+{
+	const uint8_t* bytes = (const uint8_t*)prefix;
+	uint8_t tailBytes[SHA1_POW_MAX_TAIL_BLOCKS * SHA1_BLOCK_SIZE_IN_BYTES];
+	uint32_t numOfTailBytes = prefixLength % SHA1_BLOCK_SIZE_IN_BYTES;
+	uint32_t numOfFullBytes = prefixLength - numOfTailBytes;
+	uint64_t messageLengthInBits = ((uint64_t)prefixLength + SHA1_POW_NONCE_LENGTH) * 8;
+	SHA1_ctx_t ctx;
+
+	//the full blocks in front of the nonce are the same for every nonce => hash them once
+	SHA1_ctxInit(&ctx);
+	SHA1_ctxUpdate(&ctx, bytes, numOfFullBytes);
+	memcpy(tail->m_midstate, ctx.m_hash, sizeof(tail->m_midstate));
+
+	//the rest of the prefix, the nonce characters (0 for now), the Padding and the length, as in SHA1_ctxFinal()
+	memset(tailBytes, 0, sizeof(tailBytes));
+	memcpy(tailBytes, &bytes[numOfFullBytes], numOfTailBytes);
+	tailBytes[numOfTailBytes + SHA1_POW_NONCE_LENGTH] = 0x80;
+
+	tail->m_nonceOffset = numOfTailBytes;
+	tail->m_numOfBlocks = ((numOfTailBytes + SHA1_POW_NONCE_LENGTH + 1) > SHA1_LENGTH_FIELD_OFFSET_IN_BYTES) ? 2 : 1;
+
+	for(uint8_t byteIndex = 0; byteIndex < 8; byteIndex++)
+	{
+		tailBytes[(tail->m_numOfBlocks * SHA1_BLOCK_SIZE_IN_BYTES) - 8 + byteIndex] = (uint8_t)(messageLengthInBits >> (56 - (8 * byteIndex)));
+	}
+
+	//unused second block: 0, like the other bytes the engine does not hash
+	for(uint8_t blockIndex = 0; blockIndex < SHA1_POW_MAX_TAIL_BLOCKS; blockIndex++)
+	{
+		SHA1_loadBigEndianWords(&tail->m_word[blockIndex * SHA1_TOTAL_WORDS_PER_BLOCK], &tailBytes[blockIndex * SHA1_BLOCK_SIZE_IN_BYTES]);
+	}
+}
+
+/**
+ * \brief Search the first nonce of the range whose stamp meets the target, on the CPU.
+ *
+ * The prefix is only hashed once (SHA1_powPrepare()), each nonce costs the Compression Function of the 1 or 2 tail
+ * blocks with sha_1().
+ *
+ * \param SHA1_powJob_t* job : IN/OUT - the search, the OUT members are written
+ * \return TRUE if a nonce was found, the same as job->m_isFound
+ */
+boolean_t SHA1_powSearch(SHA1_powJob_t* job)
+{
+	SHA1_powTail_t tail;
+	uint32_t foundOffset = 0;
+
+	SHA1_powPrepare(&tail, job->m_prefix, job->m_prefixLength);
+
+	job->m_isFound = SHA1_powSearchRange(&tail, job->m_targetMask, job->m_firstNonce, job->m_numOfNonces, &foundOffset, job->m_hash);
+	if(TRUE == job->m_isFound)
+	{
+		job->m_nonce = job->m_firstNonce + foundOffset;
+		job->m_numOfNoncesTried = foundOffset + 1;
+	}
+	else
+	{
+		job->m_nonce = 0;
+		job->m_numOfNoncesTried = job->m_numOfNonces;
+		memset(job->m_hash, 0, sizeof(job->m_hash));
+	}
+
+	return job->m_isFound;
+}
+
+#if !defined(__nios2__)
+/**
+ * \brief SHA1_powSearch() on several threads, with the same result.
+ *
+ * The threads take pieces of SHA1_POW_NONCES_PER_CHUNK nonces in ascending order. Once a thread has found a nonce, no
+ * piece after it is started, the pieces in front of it are searched to the end, so the lowest nonce wins.
+ * Only on the host build, there are no threads on the Nios II.
+ *
+ * \param SHA1_powJob_t* job : IN/OUT - the search, the OUT members are written
+ * \param uint32_t numOfThreads : IN - 1 or more
+ * \return TRUE if a nonce was found, the same as job->m_isFound
+ */
+boolean_t SHA1_powSearchParallel(SHA1_powJob_t* job, uint32_t numOfThreads)
+{
+	SHA1_powTail_t tail;
+	SHA1_powShared_t shared;
+	pthread_t threadId[SHA1_POW_MAX_THREADS];
+	uint32_t numOfStarted = 0;
+
+	SHA1_powPrepare(&tail, job->m_prefix, job->m_prefixLength);
+
+	shared.m_tail = &tail;
+	shared.m_targetMask = job->m_targetMask;
+	shared.m_firstNonce = job->m_firstNonce;
+	shared.m_numOfNonces = job->m_numOfNonces;
+	pthread_mutex_init(&shared.m_lock, NULL);
+	shared.m_nextOffset = 0;
+	shared.m_isFound = FALSE;
+	shared.m_foundOffset = 0;
+	memset(shared.m_hash, 0, sizeof(shared.m_hash));
+
+	if(numOfThreads > SHA1_POW_MAX_THREADS)
+	{
+		numOfThreads = SHA1_POW_MAX_THREADS;
+	}
+
+	//the calling thread is one of them. A thread that can not be created only makes the search slower
+	while((numOfStarted + 1) < numOfThreads)
+	{
+		if(0 != pthread_create(&threadId[numOfStarted], NULL, SHA1_powSearchThread, &shared))
+		{
+			break;
+		}
+		numOfStarted++;
+	}
+
+	SHA1_powSearchThread(&shared);
+
+	for(uint32_t threadIndex = 0; threadIndex < numOfStarted; threadIndex++)
+	{
+		pthread_join(threadId[threadIndex], NULL);
+	}
+	pthread_mutex_destroy(&shared.m_lock);
+
+	job->m_isFound = shared.m_isFound;
+	memcpy(job->m_hash, shared.m_hash, sizeof(job->m_hash));
+	if(TRUE == job->m_isFound)
+	{
+		job->m_nonce = job->m_firstNonce + shared.m_foundOffset;
+		job->m_numOfNoncesTried = shared.m_foundOffset + 1;
+	}
+	else
+	{
+		job->m_nonce = 0;
+		job->m_numOfNoncesTried = job->m_numOfNonces;
+	}
+
+	return job->m_isFound;
+}
+#endif
+
+/**
+ * \brief This function loads the 16 words of a 512-bit block from 64 bytes, in Big Endian.
+ *
+ * If the bytes are 4-byte aligned, whole words are loaded and byte-swapped,
+ * otherwise every byte is loaded on its own (unaligned-safe path).
+ *
+ * \param uint32_t * word : OUT - the 16 words of the 512-bit block
+ * \param const uint8_t * block : IN - 64 bytes of the message, any alignment
+ */
+static void SHA1_loadBigEndianWords(uint32_t * word, const uint8_t * block)
+{
+#if defined(__GNUC__) && defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
+
+	//aligned path: one word load + byte swap per word (Nios II and x86 are Little Endian)
+	if(((size_t)block & 3) == 0)
+	{
+		const SHA1_aliasedWord_t* alignedWord = (const SHA1_aliasedWord_t*)block;
+
+		for(uint8_t wordIndex = 0; wordIndex < SHA1_TOTAL_WORDS_PER_BLOCK; wordIndex++)
+		{
+			word[wordIndex] = __builtin_bswap32(alignedWord[wordIndex]);
+		}
+
+		return;
+	}
+
+#endif
+
+	//unaligned-safe path: put the 4 bytes into the word, in Big Endian
+	for(uint8_t wordIndex = 0; wordIndex < SHA1_TOTAL_WORDS_PER_BLOCK; wordIndex++)
+	{
+		const uint8_t* bytes = &block[4 * wordIndex];
+
+		word[wordIndex] = ((uint32_t)bytes[0] << 24) |
+						  ((uint32_t)bytes[1] << 16) |
+						  ((uint32_t)bytes[2] << 8)  |
+						  ((uint32_t)bytes[3]);
+	}
+}
+
+/**
+ * \brief This function compresses 64 bytes of the message and updates the chaining hash words.
+ *
+ * \param uint32_t * hash : IN/OUT - the 5 chaining hash words
+ * \param const uint8_t * block : IN - 64 bytes of the message, any alignment
+ */
+static void SHA1_compressBlockBytes(uint32_t * hash, const uint8_t * block)
+{
+	uint32_t word[SHA1_TOTAL_WORDS_PER_BLOCK];
+	uint32_t outputHash[SHA1_NUM_OF_HASH_WORDS_PER_BLOCK];
+
+	SHA1_loadBigEndianWords(word, block);
+
+	//sha_1() must not write into prev_hash while it still reads it => use a separate output buffer
+	sha_1(outputHash, word, hash);
+
+	hash[SHA1_HASH_A] = outputHash[SHA1_HASH_A];
+	hash[SHA1_HASH_B] = outputHash[SHA1_HASH_B];
+	hash[SHA1_HASH_C] = outputHash[SHA1_HASH_C];
+	hash[SHA1_HASH_D] = outputHash[SHA1_HASH_D];
+	hash[SHA1_HASH_E] = outputHash[SHA1_HASH_E];
+}
+
+/**
+ * \brief This function writes the 8 hex characters of a nonce into the pre-processed tail blocks of a stamp.
+ *
+ * \param uint32_t * word : IN/OUT - the words of the tail blocks, big-endian
+ * \param uint32_t nonceOffset : IN - byte offset of the first nonce character
+ * \param uint32_t nonce : IN - the nonce
+ */
+static void SHA1_powPutNonce(uint32_t * word, uint32_t nonceOffset, uint32_t nonce)
+{
+	char nonceChars[SHA1_POW_NONCE_LENGTH];
+
+	SHA1_powFormatNonce(nonceChars, nonce);
+
+	//byte 0 of a word is its most significant byte
+	for(uint8_t charIndex = 0; charIndex < SHA1_POW_NONCE_LENGTH; charIndex++)
+	{
+		uint32_t byteIndex = nonceOffset + charIndex;
+		uint8_t shift = 24 - (8 * (byteIndex & 3));
+
+		word[byteIndex >> 2] = (word[byteIndex >> 2] & ~(0xFFu << shift)) | ((uint32_t)(uint8_t)nonceChars[charIndex] << shift);
+	}
+}
+
+/**
+ * \brief This function searches a range of nonces in order and stops at the first one that meets the target.
+ *
+ * \param const SHA1_powTail_t* tail : IN - the prepared stamp
+ * \param const uint32_t * targetMask : IN - 5 words, bits of the hash that must be 0
+ * \param uint32_t firstNonce : IN - first nonce of the range
+ * \param uint32_t numOfNonces : IN - number of nonces of the range
+ * \param uint32_t* foundOffset : OUT - nonce - firstNonce of the found nonce
+ * \param uint32_t * hash_ptr : OUT - the 5 hash words of the found nonce
+ * \return TRUE if a nonce of the range meets the target
+ */
+static boolean_t SHA1_powSearchRange(const SHA1_powTail_t* tail, const uint32_t * targetMask, uint32_t firstNonce,
+		uint32_t numOfNonces, uint32_t* foundOffset, uint32_t * hash_ptr)
+{
+	uint32_t word[SHA1_POW_MAX_TAIL_BLOCKS * SHA1_TOTAL_WORDS_PER_BLOCK];
+	uint32_t blockHash[SHA1_NUM_OF_HASH_WORDS_PER_BLOCK];
+	uint32_t hash[SHA1_NUM_OF_HASH_WORDS_PER_BLOCK];
+
+	memcpy(word, tail->m_word, sizeof(word));
+
+	for(uint32_t offset = 0; offset < numOfNonces; offset++)
+	{
+		SHA1_powPutNonce(word, tail->m_nonceOffset, firstNonce + offset);
+
+		//sha_1() must not write into prev_hash while it still reads it => the second block has its own output
+		sha_1(hash, word, tail->m_midstate);
+		if(2 == tail->m_numOfBlocks)
+		{
+			memcpy(blockHash, hash, sizeof(blockHash));
+			sha_1(hash, &word[SHA1_TOTAL_WORDS_PER_BLOCK], blockHash);
+		}
+
+		if(0 == ((hash[SHA1_HASH_A] & targetMask[SHA1_HASH_A]) |
+				 (hash[SHA1_HASH_B] & targetMask[SHA1_HASH_B]) |
+				 (hash[SHA1_HASH_C] & targetMask[SHA1_HASH_C]) |
+				 (hash[SHA1_HASH_D] & targetMask[SHA1_HASH_D]) |
+				 (hash[SHA1_HASH_E] & targetMask[SHA1_HASH_E])))
+		{
+			*foundOffset = offset;
+			memcpy(hash_ptr, hash, sizeof(hash));
+			return TRUE;
+		}
+	}
+
+	return FALSE;
+}
+
+#if !defined(__nios2__)
+/**
+ * \brief One thread of SHA1_powSearchParallel(): takes the next piece of the range until there is none left in
+ * 		  front of the lowest nonce found so far.
+ *
+ * \param void* argument : IN/OUT - the SHA1_powShared_t of the search
+ * \return NULL
+ */
+static void* SHA1_powSearchThread(void* argument)
+{
+	SHA1_powShared_t* shared = (SHA1_powShared_t*)argument;
+	uint32_t hash[SHA1_NUM_OF_HASH_WORDS_PER_BLOCK];
+	uint32_t foundOffset;
+
+	for(;;)
+	{
+		uint32_t firstOffset;
+		uint32_t numOfNonces = 0;
+
+		pthread_mutex_lock(&shared->m_lock);
+		firstOffset = shared->m_nextOffset;
+		//a piece behind the nonce found so far can not have a lower one
+		if((firstOffset < shared->m_numOfNonces) && ((FALSE == shared->m_isFound) || (firstOffset < shared->m_foundOffset)))
+		{
+			numOfNonces = shared->m_numOfNonces - firstOffset;
+			if(numOfNonces > SHA1_POW_NONCES_PER_CHUNK)
+			{
+				numOfNonces = SHA1_POW_NONCES_PER_CHUNK;
+			}
+			shared->m_nextOffset = firstOffset + numOfNonces;
+		}
+		pthread_mutex_unlock(&shared->m_lock);
+
+		if(0 == numOfNonces)
+		{
+			return NULL;
+		}
+
+		if(TRUE == SHA1_powSearchRange(shared->m_tail, shared->m_targetMask, shared->m_firstNonce + firstOffset,
+				numOfNonces, &foundOffset, hash))
+		{
+			pthread_mutex_lock(&shared->m_lock);
+			if((FALSE == shared->m_isFound) || ((firstOffset + foundOffset) < shared->m_foundOffset))
+			{
+				shared->m_isFound = TRUE;
+				shared->m_foundOffset = firstOffset + foundOffset;
+				memcpy(shared->m_hash, hash, sizeof(hash));
+			}
+			pthread_mutex_unlock(&shared->m_lock);
+		}
+	}
+}
+#endif
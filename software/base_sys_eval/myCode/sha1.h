@@ -52,6 +52,19 @@
  */
 #define SHA1_BLOCK_SIZE					512		/**< in bits  */
 
+/**
+ * \brief The defined number of bytes per SHA-1 block (512 bits / 8).
+ */
+#define SHA1_BLOCK_SIZE_IN_BYTES		64		/**< in bytes */
+
+/**
+ * \brief Byte offset inside the final 512-bit block where the 64-bit length field starts.
+ *
+ * - The last 8 bytes of the final block hold the message length in bits.
+ * => Padding must fit the 0x80 byte in front of this offset, otherwise an extra block is needed.
+ */
+#define SHA1_LENGTH_FIELD_OFFSET_IN_BYTES	56		/**< in bytes */
+
 /**
  * \brief Each 512-bit block contains 16 words of size 32bit.
  * 		  1 word = 32 bits.
@@ -99,6 +112,27 @@
 #define SHA1_K_STAGE_4		0xCA62C1D6		/**< in hex */
 
 
+/**
+ * \brief Hex characters of the nonce of a proof-of-work stamp, appended to the prefix.
+ *
+ * - The 32-bit nonce is written as 8 lowercase hex characters, the most significant digit first.
+ * => The message of a stamp is prefix || 8 characters, a valid counter of a hashcash stamp.
+ */
+#define SHA1_POW_NONCE_LENGTH			8		/**< in characters */
+
+/**
+ * \brief A stamp has at most 2 tail blocks: the rest of the prefix, the nonce, the Padding and the length.
+ *
+ * - The full 64-byte blocks of the prefix are hashed once into the midstate.
+ * - The rest is 0..63 bytes, with the 8 nonce characters and at least 9 bytes of Padding and length it fits in 2 blocks.
+ */
+#define SHA1_POW_MAX_TAIL_BLOCKS		2		/**< in blocks */
+
+/**
+ * \brief Nonces of one piece of the range that a thread of SHA1_powSearchParallel() takes at a time.
+ */
+#define SHA1_POW_NONCES_PER_CHUNK		4096	/**< in nonces */
+
 //####################### Enumerations
 
 /**
@@ -137,6 +171,55 @@ struct sSHA1_Packet {
 };
 typedef struct sSHA1_Packet SHA1_packet_t;
 
+/**
+ * \brief Streaming SHA-1 context.
+ *
+ * Unlike the SHA-1 Packet Object, the context does not store the whole message.
+ * It only keeps one partial 512-bit block, the 5 chaining hash words and the 64-bit bit counter,
+ * so the memory usage is constant regardless of the message length.
+ */
+struct sSHA1_ctx {
+  uint32_t	m_hash[SHA1_NUM_OF_HASH_WORDS_PER_BLOCK];	/**< the 5 chaining hash words */
+  uint8_t	m_buffer[SHA1_BLOCK_SIZE_IN_BYTES];			/**< partial 512-bit block, waiting for more bytes */
+  uint32_t	m_bufferLength;								/**< number of bytes currently stored in m_buffer */
+  uint64_t	m_messageLengthInBits;						/**< length of the message processed so far, in bits */
+};
+typedef struct sSHA1_ctx SHA1_ctx_t;
+
+/**
+ * \brief Search of a proof-of-work stamp (hashcash-style): the first nonce of a range whose hash meets the target.
+ *
+ * The message of nonce n is m_prefix || the 8 hex characters of n (SHA1_powFormatNonce()).
+ * A hash meets the target if hash & m_targetMask is 0 in all 5 words, see SHA1_powTargetMask().
+ * The nonces go from m_firstNonce up, modulo 2^32.
+ */
+struct sSHA1_powJob {
+  const void*	m_prefix;									/**< IN - the fixed part of the stamp, any alignment */
+  uint32_t		m_prefixLength;								/**< IN - number of bytes in m_prefix */
+  uint32_t		m_firstNonce;								/**< IN - first nonce to try */
+  uint32_t		m_numOfNonces;								/**< IN - number of nonces to try */
+  uint32_t		m_targetMask[SHA1_NUM_OF_HASH_WORDS_PER_BLOCK];	/**< IN - bits of the hash that must be 0 */
+  boolean_t		m_isFound;									/**< OUT - TRUE if a nonce of the range meets the target */
+  uint32_t		m_nonce;									/**< OUT - the first nonce that meets the target */
+  uint32_t		m_hash[SHA1_NUM_OF_HASH_WORDS_PER_BLOCK];	/**< OUT - the hash of the stamp with m_nonce */
+  uint32_t		m_numOfNoncesTried;							/**< OUT - up to and including m_nonce, or all of the range */
+};
+typedef struct sSHA1_powJob SHA1_powJob_t;
+
+/**
+ * \brief The part of a stamp that changes with the nonce, prepared once per prefix.
+ *
+ * Every nonce only needs the Compression Function of the tail blocks, starting from the midstate.
+ * The same data goes into the registers of the search engine (SHA1_POW_REG_MIDSTATE and SHA1_POW_REG_TAIL of "sha1_accel.h").
+ */
+struct sSHA1_powTail {
+  uint32_t	m_midstate[SHA1_NUM_OF_HASH_WORDS_PER_BLOCK];	/**< the hash words after the full blocks of the prefix */
+  uint32_t	m_word[SHA1_POW_MAX_TAIL_BLOCKS * SHA1_TOTAL_WORDS_PER_BLOCK];	/**< the pre-processed tail blocks, the nonce characters 0 */
+  uint32_t	m_nonceOffset;									/**< byte offset of the first nonce character in m_word, 0..63 */
+  uint32_t	m_numOfBlocks;									/**< 1 or 2 */
+};
+typedef struct sSHA1_powTail SHA1_powTail_t;
+
 
 /*****************************************************************************/
 /* API functions                                                             */
@@ -153,6 +236,15 @@ typedef struct sSHA1_Packet SHA1_packet_t;
  */
 void SHA1_init(SHA1_packet_t* packet, MSG_message_t* message);
 
+/**
+ * \brief Exact number of 512-bit blocks of a pre-processed message: the full 64-byte blocks plus 1 or 2 tail blocks
+ * 		  with the Padding and the 64-bit length.
+ *
+ * \param uint64_t messageLength : IN - length of the original message, in bytes
+ * \return number of 512-bit blocks
+ */
+uint64_t SHA1_getNumOf512bitBlocks(uint64_t messageLength);
+
 /**
  * \brief Print out the pre-processed blocks of the SHA-1 packet on the Eclipse Console
  *
@@ -172,6 +264,80 @@ void SHA1_printPreProcessedPacket(SHA1_packet_t* packet);
  */
 void sha_1(uint32_t * hash_ptr, const uint32_t * message, const uint32_t * prev_hash);
 
+/**
+ * \brief Compression Function with per-round stage dispatch.
+ *
+ * Each of the 80 rounds checks which stage it belongs to and calls the matching kernel function.
+ * This is the original implementation of sha_1(), kept as reference for the other implementations.
+ *
+ * \param uint32_t * hash_ptr : OUT - pointer to the processed hash
+ * \param const uint32_t * message : IN - the pre-processed 512-bit wide input message
+ * \param const uint32_t * prev_hash : IN - pointer to the initial hash
+ */
+void SHA1_compressStageDispatch(uint32_t * hash_ptr, const uint32_t * message, const uint32_t * prev_hash);
+
+/**
+ * \brief Compression Function with the 4 stages x 20 rounds fully unrolled.
+ *
+ * The 5 hash words are rotated between the rounds by renaming instead of copying,
+ * so there are no range checks, no kernel function calls and no array copies.
+ * The message schedule is selected by SHA1_CONFIG_SCHEDULE.
+ * hash_ptr may point to the same array as prev_hash.
+ *
+ * \param uint32_t * hash_ptr : OUT - pointer to the processed hash
+ * \param const uint32_t * message : IN - the pre-processed 512-bit wide input message
+ * \param const uint32_t * prev_hash : IN - pointer to the initial hash
+ */
+void SHA1_compressUnrolled(uint32_t * hash_ptr, const uint32_t * message, const uint32_t * prev_hash);
+
+/**
+ * \brief SHA1_compressUnrolled() with the 80-word expanded message schedule (SHA1_SCHEDULE_EXPANDED_80).
+ *
+ * Always available, whatever SHA1_CONFIG_SCHEDULE selects, so the benchmark can compare both schedules.
+ * hash_ptr may point to the same array as prev_hash.
+ *
+ * \param uint32_t * hash_ptr : OUT - pointer to the processed hash
+ * \param const uint32_t * message : IN - the pre-processed 512-bit wide input message
+ * \param const uint32_t * prev_hash : IN - pointer to the initial hash
+ */
+void SHA1_compressUnrolledExpanded80(uint32_t * hash_ptr, const uint32_t * message, const uint32_t * prev_hash);
+
+/**
+ * \brief SHA1_compressUnrolled() with the 16-word rolling message schedule (SHA1_SCHEDULE_ROLLING_16).
+ *
+ * Always available, whatever SHA1_CONFIG_SCHEDULE selects, so the benchmark can compare both schedules.
+ * hash_ptr may point to the same array as prev_hash.
+ *
+ * \param uint32_t * hash_ptr : OUT - pointer to the processed hash
+ * \param const uint32_t * message : IN - the pre-processed 512-bit wide input message
+ * \param const uint32_t * prev_hash : IN - pointer to the initial hash
+ */
+void SHA1_compressUnrolledRolling16(uint32_t * hash_ptr, const uint32_t * message, const uint32_t * prev_hash);
+
+/**
+ * \brief Compression Function on the SHA-1 round step custom instruction of the Nios II.
+ *
+ * One instruction per round, the hash words stay in the instruction, see "sha1_ci.h".
+ * Without the instruction in the system (e.g. on the host) it runs on the C model of the instruction.
+ * Must not be called from an interrupt handler.
+ * hash_ptr may point to the same array as prev_hash.
+ *
+ * \param uint32_t * hash_ptr : OUT - pointer to the processed hash
+ * \param const uint32_t * message : IN - the pre-processed 512-bit wide input message
+ * \param const uint32_t * prev_hash : IN - pointer to the initial hash
+ */
+void SHA1_compressCustomInstr(uint32_t * hash_ptr, const uint32_t * message, const uint32_t * prev_hash);
+
+/**
+ * \brief This function expands the 16 words of the current 512-bit block in to 80 words.
+ *
+ * Used by SHA1_compressStageDispatch(), and on its own by the benchmark to time the expansion phase.
+ *
+ * \param const uint32_t * message : IN - the pre-processed 512-bit wide input message
+ * \param uint32_t * expandedWord : OUT - array of 80 expanded words, owned by the caller
+ */
+void SHA1_wordExpansion(const uint32_t * message, uint32_t * expandedWord);
+
 /**
  * \brief This function takes the output hash of the current 512-bit block and assigns
  * 		  to the input hash of the next 512-bit block
@@ -181,6 +347,17 @@ void sha_1(uint32_t * hash_ptr, const uint32_t * message, const uint32_t * prev_
  */
 void SHA1_updateInputHashForNextBlock(SHA1_packet_t* packet, uint64_t blockIndex);
 
+/**
+ * \brief Run the Compression Function over all 512-bit blocks of the SHA-1 packet, in order.
+ *
+ * Each block starts from the output hash of the previous one, the final hash is the output hash of the last block.
+ * With SHA1_COMPRESSION_AVALON_ACCEL the accelerator keeps the chaining value itself: only the blocks are written,
+ * and only the output hash of the last block is filled in.
+ *
+ * \param SHA1_packet_t* packet : IN/OUT - the pre-processed SHA-1 Packet Object
+ */
+void SHA1_processPacket(SHA1_packet_t* packet);
+
 /**
  * \brief free the memory allocated for the member of the objects in the argument list.
  *
@@ -196,4 +373,102 @@ void SHA1_freeMemory(SHA1_packet_t* packet);
  */
 void SHA1_printFinalHash(SHA1_packet_t* packet, MSG_message_t* message);
 
+/**
+ * \brief Initialization of the streaming SHA-1 context.
+ *
+ * The chaining hash words are set to the magic numbers (FIPS PUB 180-1),
+ * the partial block buffer and the bit counter are cleared.
+ *
+ * \param SHA1_ctx_t* ctx : OUT - the streaming SHA-1 context
+ */
+void SHA1_ctxInit(SHA1_ctx_t* ctx);
+
+/**
+ * \brief Feed the next part of the message into the streaming SHA-1 context.
+ *
+ * Each time the partial block buffer is full, the 512-bit block is compressed immediately,
+ * so the function can be called any number of times with pieces of any length.
+ * Whole 512-bit blocks are compressed straight from the caller's buffer, only the
+ * leftover bytes are copied into the partial block buffer.
+ *
+ * \param SHA1_ctx_t* ctx : IN/OUT - the streaming SHA-1 context
+ * \param const void* data : IN - the next bytes of the message, any alignment, may contain '\0'
+ * \param uint64_t length : IN - number of bytes in data
+ */
+void SHA1_ctxUpdate(SHA1_ctx_t* ctx, const void* data, uint64_t length);
+
+/**
+ * \brief Finish the streaming SHA-1 computation.
+ *
+ * The Padding and the 64-bit representation of the message length are added to the
+ * partial block (or to one extra block if there is no space left) and compressed.
+ *
+ * \param SHA1_ctx_t* ctx : IN/OUT - the streaming SHA-1 context
+ * \param uint32_t * hash_ptr : OUT - the 5 final hash words
+ */
+void SHA1_ctxFinal(SHA1_ctx_t* ctx, uint32_t * hash_ptr);
+
+/**
+ * \brief Hash a whole message that is already in memory, in one call.
+ *
+ * The 512-bit blocks are loaded straight from the caller's buffer, no heap memory is used
+ * and the data is not copied, except for the last partial block that needs the Padding.
+ *
+ * \param uint32_t * hash_ptr : OUT - the 5 final hash words
+ * \param const void* data : IN - the message, any alignment, may contain '\0'
+ * \param uint64_t length : IN - number of bytes in data
+ */
+void SHA1_hashBuffer(uint32_t * hash_ptr, const void* data, uint64_t length);
+
+/**
+ * \brief The 8 hex characters of a nonce, as they are appended to the prefix of a stamp.
+ *
+ * \param char* nonceChars : OUT - SHA1_POW_NONCE_LENGTH lowercase hex characters, not terminated
+ * \param uint32_t nonce : IN - the nonce
+ */
+void SHA1_powFormatNonce(char* nonceChars, uint32_t nonce);
+
+/**
+ * \brief Target mask of a hash with at least numOfZeroBits leading zero bits, the difficulty of a hashcash stamp.
+ *
+ * \param uint32_t * targetMask : OUT - 5 words, the leading numOfZeroBits bits set, word 0 = hash word A
+ * \param uint32_t numOfZeroBits : IN - 0..160
+ */
+void SHA1_powTargetMask(uint32_t * targetMask, uint32_t numOfZeroBits);
+
+/**
+ * \brief Hash the full blocks of the prefix into the midstate and pre-process the tail blocks of a stamp.
+ *
+ * \param SHA1_powTail_t* tail : OUT - midstate, tail blocks and offset of the nonce characters
+ * \param const void* prefix : IN - the fixed part of the stamp, any alignment
+ * \param uint32_t prefixLength : IN - number of bytes in prefix
+ */
+void SHA1_powPrepare(SHA1_powTail_t* tail, const void* prefix, uint32_t prefixLength);
+
+/**
+ * \brief Search the first nonce of the range whose stamp meets the target, on the CPU.
+ *
+ * The prefix is only hashed once (SHA1_powPrepare()), each nonce costs the Compression Function of the 1 or 2 tail
+ * blocks with sha_1().
+ *
+ * \param SHA1_powJob_t* job : IN/OUT - the search, the OUT members are written
+ * \return TRUE if a nonce was found, the same as job->m_isFound
+ */
+boolean_t SHA1_powSearch(SHA1_powJob_t* job);
+
+#if !defined(__nios2__)
+/**
+ * \brief SHA1_powSearch() on several threads, with the same result.
+ *
+ * The threads take pieces of SHA1_POW_NONCES_PER_CHUNK nonces in ascending order. Once a thread has found a nonce, no
+ * piece after it is started, the pieces in front of it are searched to the end, so the lowest nonce wins.
+ * Only on the host build, there are no threads on the Nios II.
+ *
+ * \param SHA1_powJob_t* job : IN/OUT - the search, the OUT members are written
+ * \param uint32_t numOfThreads : IN - 1 or more
+ * \return TRUE if a nonce was found, the same as job->m_isFound
+ */
+boolean_t SHA1_powSearchParallel(SHA1_powJob_t* job, uint32_t numOfThreads);
+#endif
+
 #endif /* SHA1_H_ */
@@ -0,0 +1,768 @@
+/**
+* \file   sha1_accel.c
+* \author Trung Tin Nguyen (1120436), and Dung Anh Huynh Pham (764527)
+* \date   17.10.2026
+*
+* \brief Driver of the SHA-1 accelerator, an Avalon-MM slave with the register map of sha1_accel.h
+*
+* \copyright Copyright 2023
+* Department of electrical engineering and information technology, Hochschule Darmstadt - University of applied sciences (h_da). All Rights Reserved.
+* Permission to use, copy, modify, and distribute this software and its documentation for educational, and research purposes in the context of non-commercial
+* (unless permitted by h_da) and official h_da projects, is hereby granted for enrolled students of h_da, provided that the above copyright notice,
+* this paragraph and the following paragraph appear in all copies, modifications, and distributions.
+*
+* Contact Prof.Dr. C. Jakob, christian.jakob@h-da.de, Birkenweg 8 64295 Darmstadt - GERMANY for commercial requests.
+*
+* \warning This software is a PROTOTYPE version and is not designed or intended for use in production, especially not for safety-critical applications!
+* The user represents and warrants that it will NOT use or redistribute the Software for such purposes.
+* This prototype is for research purposes only. This software is provided "AS IS," without a warranty of any kind.
+*/
+
+
+/*****************************************************************************/
+/* Include files                                                             */
+/*****************************************************************************/
+#include <string.h>	//for the usage of memcpy()
+
+#include "sha1.h"
+#include "sha1_accel.h"
+
+
+/*****************************************************************************/
+/* Local type definitions ('typedef')                                        */
+/*****************************************************************************/
+
+/**
+ * \brief Word type for loading the message straight from the caller's byte buffer, as in "sha1.c".
+ */
+#if defined(__GNUC__)
+typedef uint32_t __attribute__((__may_alias__)) SHA1_accelAliasedWord_t;
+#else
+typedef uint32_t SHA1_accelAliasedWord_t;
+#endif
+
+
+/*****************************************************************************/
+/* Local variable definitions ('static')                                     */
+/*****************************************************************************/
+
+#if defined(SHA1_ACCEL)
+/**
+ * \brief Destination of the DMA master, a whole data cache line that the CPU never writes.
+ *
+ * It is only read through the cache bypass, so no stale or dirty cache line can get in the way of the hash.
+ */
+static uint32_t SHA1_accelDmaHash[NIOS2_DCACHE_LINE_SIZE / sizeof(uint32_t)] __attribute__((aligned(NIOS2_DCACHE_LINE_SIZE)));
+
+/**
+ * \brief Descriptor ring, only written through the cache bypass, read by the DMA master.
+ */
+static SHA1_ACCEL_DESCRIPTOR_TYPE SHA1_accelRing[SHA1_ACCEL_RING_SIZE] __attribute__((aligned(NIOS2_DCACHE_LINE_SIZE)));
+
+/**
+ * \brief Destination of the hash of each descriptor, a data cache line each, read like SHA1_accelDmaHash.
+ */
+static uint32_t SHA1_accelRingHash[SHA1_ACCEL_RING_SIZE][NIOS2_DCACHE_LINE_SIZE / sizeof(uint32_t)] __attribute__((aligned(NIOS2_DCACHE_LINE_SIZE)));
+
+//job of each descriptor, SHA1_accelRingCollect() writes its m_hash
+static SHA1_accelJob_t* SHA1_accelRingJob[SHA1_ACCEL_RING_SIZE];
+
+//next free descriptor (RING_HEAD), and the oldest job that is not collected yet
+static uint32_t SHA1_accelRingHead = 0;
+static uint32_t SHA1_accelRingTail = 0;
+#endif
+
+
+/*****************************************************************************/
+/* Local function prototypes ('static')                                      */
+/*****************************************************************************/
+
+#if defined(SHA1_ACCEL) || defined(SHA1_ARRAY)
+static void SHA1_accelFlushDataCache(const void* start, uint32_t length);
+#endif
+#if defined(SHA1_ACCEL)
+static void SHA1_accelWriteData(const uint8_t* bytes, uint64_t numOfWords);
+static void SHA1_accelWriteEnd(uint32_t * hash_ptr, const uint8_t* bytes, uint8_t numOfTailBytes);
+#endif
+
+
+/*****************************************************************************/
+/* Function implementation - global ('extern') and local ('static')          */
+/*****************************************************************************/
+
+#if defined(SHA1_ACCEL)
+
+/**
+ * \brief Compression Function on the SHA-1 accelerator.
+ *
+ * Writes the block and the chaining value into the registers, starts the core and polls DONE.
+ * hash_ptr may point to the same array as prev_hash.
+ * Only available if the accelerator is in the system, i.e. SHA1_ACCEL_BASE is defined in "system.h".
+ *
+ * \param uint32_t * hash_ptr : OUT - pointer to the processed hash
+ * \param const uint32_t * message : IN - the pre-processed 512-bit wide input message
+ * \param const uint32_t * prev_hash : IN - pointer to the initial hash
+ */
+void SHA1_accelCompress(uint32_t * hash_ptr, const uint32_t * message, const uint32_t * prev_hash)
+{
+	//the registers are copied into the core at START, so they are written while a previous block may still run
+	for(uint8_t hashIndex = 0; hashIndex < SHA1_NUM_OF_HASH_WORDS_PER_BLOCK; hashIndex++)
+	{
+		SHA1_ACCEL.HASH_IN_REG[hashIndex] = prev_hash[hashIndex];
+	}
+
+	for(uint8_t wordIndex = 0; wordIndex < SHA1_TOTAL_WORDS_PER_BLOCK; wordIndex++)
+	{
+		SHA1_ACCEL.MESSAGE_REG[wordIndex] = message[wordIndex];
+	}
+
+	//wait for a previous block, START is ignored while the core is busy
+	while(SHA1_ACCEL.CTRL_REG & SHA1_ACCEL_STATUS_BUSY);
+
+	//START clears DONE, it is set again 80 / ROUNDS_PER_CYCLE clock cycles later
+	SHA1_ACCEL.CTRL_REG = SHA1_ACCEL_CTRL_START;
+
+	while(!(SHA1_ACCEL.CTRL_REG & SHA1_ACCEL_STATUS_DONE));
+
+	for(uint8_t hashIndex = 0; hashIndex < SHA1_NUM_OF_HASH_WORDS_PER_BLOCK; hashIndex++)
+	{
+		hash_ptr[hashIndex] = SHA1_ACCEL.DIGEST_REG[hashIndex];
+	}
+}
+
+/**
+ * \brief Hash a whole message on the SHA-1 accelerator, without Pre-Processing on the CPU.
+ *
+ * The bytes are written to DATA in memory order (byte lane 0 first), the last 0..3 bytes to DATA_END.
+ * The accelerator counts the length, inserts the Padding and chains the blocks, the CPU only polls DONE at the end.
+ * Only available if the accelerator is in the system, i.e. SHA1_ACCEL_BASE is defined in "system.h".
+ *
+ * \param uint32_t * hash_ptr : OUT - the 5 final hash words
+ * \param const void* data : IN - the message, any alignment, may contain '\0'
+ * \param uint64_t length : IN - number of bytes in data
+ */
+void SHA1_accelHashBuffer(uint32_t * hash_ptr, const void* data, uint64_t length)
+{
+	static const uint32_t initHash[SHA1_NUM_OF_HASH_WORDS_PER_BLOCK] = {
+		SHA1_INIT_HASH_A, SHA1_INIT_HASH_B, SHA1_INIT_HASH_C, SHA1_INIT_HASH_D, SHA1_INIT_HASH_E};
+
+	const uint8_t* bytes = (const uint8_t*)data;
+	uint64_t numOfWords = length / 4;
+
+	//the first block of the message starts from HASH_IN
+	for(uint8_t hashIndex = 0; hashIndex < SHA1_NUM_OF_HASH_WORDS_PER_BLOCK; hashIndex++)
+	{
+		SHA1_ACCEL.HASH_IN_REG[hashIndex] = initHash[hashIndex];
+	}
+
+	SHA1_accelWriteData(bytes, numOfWords);
+	SHA1_accelWriteEnd(hash_ptr, &bytes[numOfWords * 4], (uint8_t)(length % 4));
+}
+
+/**
+ * \brief Empty all hash contexts and set HASH_IN to the initial hash, before the first SHA1_accelStreamUpdate().
+ *
+ * Context 0 is active afterwards. SHA1_accelHashBuffer() uses the active context, too, it must be empty then.
+ * Only available if the accelerator is in the system, i.e. SHA1_ACCEL_BASE is defined in "system.h".
+ *
+ * \return the number of hash contexts of the accelerator
+ */
+uint32_t SHA1_accelContextInit(void)
+{
+	static const uint32_t initHash[SHA1_NUM_OF_HASH_WORDS_PER_BLOCK] = {
+		SHA1_INIT_HASH_A, SHA1_INIT_HASH_B, SHA1_INIT_HASH_C, SHA1_INIT_HASH_D, SHA1_INIT_HASH_E};
+	SHA1_accelContext_t empty;
+	uint32_t numOfContexts = SHA1_ACCEL_CONFIG_NUM_OF_CONTEXTS(SHA1_ACCEL.CONFIG_REG);
+
+	//the first block of every stream starts from HASH_IN, the later ones from the chaining value of their context
+	for(uint8_t hashIndex = 0; hashIndex < SHA1_NUM_OF_HASH_WORDS_PER_BLOCK; hashIndex++)
+	{
+		SHA1_ACCEL.HASH_IN_REG[hashIndex] = initHash[hashIndex];
+	}
+
+	memset(&empty, 0, sizeof(empty));
+	empty.m_word[SHA1_ACCEL_CONTEXT_WORD_FLAGS] = SHA1_ACCEL_CONTEXT_FLAG_FIRST;
+
+	for(uint32_t contextId = numOfContexts; contextId > 0; contextId--)
+	{
+		SHA1_ACCEL.CONTEXT_ID_REG = contextId - 1;
+		SHA1_accelRestoreContext(&empty);
+	}
+
+	return numOfContexts;
+}
+
+/**
+ * \brief Switch the stream mode to another hash context, one register write.
+ *
+ * The write waits (waitrequest) until the blocks of the active context are done, then the accelerator saves it
+ * and loads the other one in the same clock cycle.
+ * Only available if the accelerator is in the system, i.e. SHA1_ACCEL_BASE is defined in "system.h".
+ *
+ * \param uint32_t contextId : IN - 0 .. SHA1_accelContextInit() - 1
+ */
+void SHA1_accelSelectContext(uint32_t contextId)
+{
+	SHA1_ACCEL.CONTEXT_ID_REG = contextId;
+}
+
+/**
+ * \brief Add the next part of the message of the active hash context.
+ *
+ * Only available if the accelerator is in the system, i.e. SHA1_ACCEL_BASE is defined in "system.h".
+ *
+ * \param const void* data : IN - the next bytes of the message, any alignment
+ * \param uint32_t length : IN - number of bytes in data, a multiple of 4: only the end of a message may have a part of a word
+ */
+void SHA1_accelStreamUpdate(const void* data, uint32_t length)
+{
+	SHA1_accelWriteData((const uint8_t*)data, length / 4);
+}
+
+/**
+ * \brief Add the last part of the message of the active hash context and read its hash.
+ *
+ * The context is empty afterwards, ready for the next message.
+ * Only available if the accelerator is in the system, i.e. SHA1_ACCEL_BASE is defined in "system.h".
+ *
+ * \param uint32_t * hash_ptr : OUT - the 5 final hash words
+ * \param const void* data : IN - the last bytes of the message, any alignment
+ * \param uint32_t length : IN - number of bytes in data, any number
+ */
+void SHA1_accelStreamFinal(uint32_t * hash_ptr, const void* data, uint32_t length)
+{
+	const uint8_t* bytes = (const uint8_t*)data;
+	uint32_t numOfWords = length / 4;
+
+	SHA1_accelWriteData(bytes, numOfWords);
+	SHA1_accelWriteEnd(hash_ptr, &bytes[numOfWords * 4], (uint8_t)(length % 4));
+}
+
+/**
+ * \brief Copy the active hash context to memory, to free its slot for another stream.
+ *
+ * Only available if the accelerator is in the system, i.e. SHA1_ACCEL_BASE is defined in "system.h".
+ *
+ * \param SHA1_accelContext_t* context : OUT - the state of the message of the active context
+ */
+void SHA1_accelSaveContext(SHA1_accelContext_t* context)
+{
+	//the write waits until the last block of the context is done, CONTEXT_DATA then counts up from word 0
+	SHA1_ACCEL.CONTEXT_INDEX_REG = 0;
+
+	for(uint8_t wordIndex = 0; wordIndex < SHA1_ACCEL_CONTEXT_NUM_OF_WORDS; wordIndex++)
+	{
+		context->m_word[wordIndex] = SHA1_ACCEL.CONTEXT_DATA_REG;
+	}
+}
+
+/**
+ * \brief Replace the active hash context with one from memory, saved by SHA1_accelSaveContext().
+ *
+ * Only available if the accelerator is in the system, i.e. SHA1_ACCEL_BASE is defined in "system.h".
+ *
+ * \param const SHA1_accelContext_t* context : IN - the state of the message
+ */
+void SHA1_accelRestoreContext(const SHA1_accelContext_t* context)
+{
+	SHA1_ACCEL.CONTEXT_INDEX_REG = 0;
+
+	for(uint8_t wordIndex = 0; wordIndex < SHA1_ACCEL_CONTEXT_NUM_OF_WORDS; wordIndex++)
+	{
+		SHA1_ACCEL.CONTEXT_DATA_REG = context->m_word[wordIndex];
+	}
+}
+
+/**
+ * \brief Start a new message in the chained mode: the next block starts from the initial hash.
+ *
+ * Drops the result of a block that is still running.
+ * Only available if the accelerator is in the system, i.e. SHA1_ACCEL_BASE is defined in "system.h".
+ */
+void SHA1_accelNewMessage(void)
+{
+	SHA1_ACCEL.CTRL_REG = SHA1_ACCEL_CTRL_NEW_MESSAGE;
+}
+
+/**
+ * \brief Hash the next pre-processed block of the message, chained to the previous one inside the accelerator.
+ *
+ * Only writes the 16 words to the free bank and returns, the core starts the block as soon as the previous one
+ * is done. The writes only wait (waitrequest) while both banks are full, i.e. two blocks wait for the core.
+ * Only available if the accelerator is in the system, i.e. SHA1_ACCEL_BASE is defined in "system.h".
+ *
+ * \param const uint32_t * message : IN - the pre-processed 512-bit wide input message
+ */
+void SHA1_accelChainBlock(const uint32_t * message)
+{
+	//the bank of the running block is free again, the core copied it at its start
+	for(uint8_t wordIndex = 0; wordIndex < SHA1_TOTAL_WORDS_PER_BLOCK; wordIndex++)
+	{
+		SHA1_ACCEL.CHAIN_MESSAGE_REG[wordIndex] = message[wordIndex];
+	}
+}
+
+/**
+ * \brief Wait for the last chained block and read the hash of the message.
+ *
+ * Only available if the accelerator is in the system, i.e. SHA1_ACCEL_BASE is defined in "system.h".
+ *
+ * \param uint32_t * hash_ptr : OUT - the 5 hash words after the last block
+ */
+void SHA1_accelGetDigest(uint32_t * hash_ptr)
+{
+	//word 15 of the last block cleared DONE
+	while(!(SHA1_ACCEL.CTRL_REG & SHA1_ACCEL_STATUS_DONE));
+
+	for(uint8_t hashIndex = 0; hashIndex < SHA1_NUM_OF_HASH_WORDS_PER_BLOCK; hashIndex++)
+	{
+		hash_ptr[hashIndex] = SHA1_ACCEL.DIGEST_REG[hashIndex];
+	}
+}
+
+/**
+ * \brief Start hashing a message in memory with the DMA master of the accelerator, without waiting for it.
+ *
+ * The accelerator reads the message from memory itself, through the second port of sys_mem, and writes the hash
+ * into a buffer of the driver when it is done. The CPU does not touch the message and may do other work,
+ * SHA1_accelDmaWait() waits for the end. The message may not be written until then.
+ * Only available if the accelerator is in the system, i.e. SHA1_ACCEL_BASE is defined in "system.h".
+ *
+ * \param const void* data : IN - the message, aligned to 4 bytes, in sys_mem
+ * \param uint32_t length : IN - number of bytes in data
+ */
+void SHA1_accelDmaStart(const void* data, uint32_t length)
+{
+	//the message must be in memory, not only in the data cache.
+	//The line of the hash may still be dirty from the start-up code, it must not be written back over the hash.
+	SHA1_accelFlushDataCache(data, length);
+	SHA1_accelFlushDataCache(SHA1_accelDmaHash, sizeof(SHA1_accelDmaHash));
+
+	//the master sees the memory at the same addresses as the CPU, without the bit that bypasses the data cache
+	SHA1_ACCEL.DMA_SRC_REG = (alt_u32)data & ~0x80000000u;
+	SHA1_ACCEL.DMA_LENGTH_REG = length;
+	SHA1_ACCEL.DMA_DST_REG = (alt_u32)SHA1_accelDmaHash;
+
+	//clears DONE, it is set again when the hash is in memory
+	SHA1_ACCEL.CTRL_REG = SHA1_ACCEL_CTRL_DMA_START;
+}
+
+/**
+ * \brief Wait until the accelerator has written the hash of SHA1_accelDmaStart() into memory, and copy it.
+ *
+ * Only available if the accelerator is in the system, i.e. SHA1_ACCEL_BASE is defined in "system.h".
+ *
+ * \param uint32_t * hash_ptr : OUT - the 5 final hash words
+ */
+void SHA1_accelDmaWait(uint32_t * hash_ptr)
+{
+	volatile uint32_t* dmaHash = (volatile uint32_t*)((alt_u32)SHA1_accelDmaHash | 0x80000000u);
+
+	while(!(SHA1_ACCEL.CTRL_REG & SHA1_ACCEL_STATUS_DONE));
+
+	for(uint8_t hashIndex = 0; hashIndex < SHA1_NUM_OF_HASH_WORDS_PER_BLOCK; hashIndex++)
+	{
+		hash_ptr[hashIndex] = dmaHash[hashIndex];
+	}
+}
+
+/**
+ * \brief Set up the descriptor ring of the driver and empty it.
+ *
+ * The ring has SHA1_ACCEL_RING_SIZE descriptors and one hash buffer of a data cache line per descriptor.
+ * Waits for jobs that are still queued, their hashes are not collected.
+ * Only available if the accelerator is in the system, i.e. SHA1_ACCEL_BASE is defined in "system.h".
+ *
+ * \param boolean_t isIrqEnabled : IN - TRUE: the interrupt line of the accelerator goes high at the end of a batch
+ */
+void SHA1_accelRingInit(boolean_t isIrqEnabled)
+{
+	//RING_SIZE may not change under a running job
+	while(SHA1_ACCEL.CTRL_REG & SHA1_ACCEL_STATUS_DMA_BUSY);
+
+	//the start-up code may have left dirty lines, they must not be written back over the descriptors or the hashes
+	SHA1_accelFlushDataCache(SHA1_accelRing, sizeof(SHA1_accelRing));
+	SHA1_accelFlushDataCache(SHA1_accelRingHash, sizeof(SHA1_accelRingHash));
+
+	//the write of RING_SIZE empties the ring: RING_HEAD = RING_TAIL = 0
+	SHA1_ACCEL.RING_BASE_REG = (alt_u32)SHA1_accelRing;
+	SHA1_ACCEL.RING_SIZE_REG = SHA1_ACCEL_RING_SIZE;
+	SHA1_ACCEL.IRQ_STATUS_REG = SHA1_ACCEL_IRQ_RING;
+	SHA1_ACCEL.IRQ_ENABLE_REG = (TRUE == isIrqEnabled) ? SHA1_ACCEL_IRQ_RING : 0;
+
+	SHA1_accelRingHead = 0;
+	SHA1_accelRingTail = 0;
+}
+
+/**
+ * \brief Queue a batch of messages in the descriptor ring, the accelerator starts on them right away.
+ *
+ * Queues as many jobs as there are free descriptors, the last one of them gets the IRQ flag. RING_HEAD is written
+ * once for the whole batch. The messages may not be written until SHA1_accelRingCollect() has returned their jobs.
+ * Only available if the accelerator is in the system, i.e. SHA1_ACCEL_BASE is defined in "system.h".
+ *
+ * \param SHA1_accelJob_t* jobs : IN - array of jobs, must stay valid until they are collected
+ * \param uint32_t numOfJobs : IN - number of jobs in the array
+ * \return number of jobs queued, from the start of the array, 0 if the ring is full
+ */
+uint32_t SHA1_accelRingSubmit(SHA1_accelJob_t* jobs, uint32_t numOfJobs)
+{
+	volatile SHA1_ACCEL_DESCRIPTOR_TYPE* ring = (volatile SHA1_ACCEL_DESCRIPTOR_TYPE*)((alt_u32)SHA1_accelRing | 0x80000000u);
+
+	//one descriptor always stays free, RING_HEAD == RING_TAIL is the empty ring.
+	//The descriptors of jobs that are not collected yet still hold their hashes.
+	uint32_t numOfFree = (SHA1_accelRingTail + SHA1_ACCEL_RING_SIZE - 1 - SHA1_accelRingHead) % SHA1_ACCEL_RING_SIZE;
+	uint32_t numOfQueued = (numOfJobs < numOfFree) ? numOfJobs : numOfFree;
+	uint32_t ringIndex = SHA1_accelRingHead;
+
+	for(uint32_t jobIndex = 0; jobIndex < numOfQueued; jobIndex++)
+	{
+		//the message must be in memory, not only in the data cache
+		SHA1_accelFlushDataCache(jobs[jobIndex].m_data, jobs[jobIndex].m_length);
+
+		ring[ringIndex].SRC_ADDRESS = (alt_u32)jobs[jobIndex].m_data & ~0x80000000u;
+		ring[ringIndex].LENGTH = jobs[jobIndex].m_length;
+		ring[ringIndex].DST_ADDRESS = (alt_u32)SHA1_accelRingHash[ringIndex];
+		ring[ringIndex].FLAGS = (jobIndex == (numOfQueued - 1)) ? SHA1_ACCEL_DESCRIPTOR_FLAG_IRQ : 0;
+
+		SHA1_accelRingJob[ringIndex] = &jobs[jobIndex];
+		ringIndex = (ringIndex + 1) % SHA1_ACCEL_RING_SIZE;
+	}
+
+	//the descriptors are in memory, the accelerator may fetch them now
+	if(numOfQueued > 0)
+	{
+		SHA1_accelRingHead = ringIndex;
+		SHA1_ACCEL.RING_HEAD_REG = SHA1_accelRingHead;
+	}
+
+	return numOfQueued;
+}
+
+/**
+ * \brief Copy the hashes of the jobs the accelerator has finished into their m_hash, without waiting.
+ *
+ * Clears the interrupt of the ring, so it may be called from the interrupt handler.
+ * Only available if the accelerator is in the system, i.e. SHA1_ACCEL_BASE is defined in "system.h".
+ *
+ * \return number of jobs finished since the last call, in the order they were queued
+ */
+uint32_t SHA1_accelRingCollect(void)
+{
+	uint32_t numOfCollected = 0;
+
+	//clear before RING_TAIL is read: a batch that ends after the read raises the interrupt again
+	SHA1_ACCEL.IRQ_STATUS_REG = SHA1_ACCEL_IRQ_RING;
+
+	uint32_t ringTail = SHA1_ACCEL.RING_TAIL_REG;
+
+	while(SHA1_accelRingTail != ringTail)
+	{
+		volatile uint32_t* ringHash = (volatile uint32_t*)((alt_u32)SHA1_accelRingHash[SHA1_accelRingTail] | 0x80000000u);
+		SHA1_accelJob_t* job = SHA1_accelRingJob[SHA1_accelRingTail];
+
+		for(uint8_t hashIndex = 0; hashIndex < SHA1_NUM_OF_HASH_WORDS_PER_BLOCK; hashIndex++)
+		{
+			job->m_hash[hashIndex] = ringHash[hashIndex];
+		}
+
+		SHA1_accelRingTail = (SHA1_accelRingTail + 1) % SHA1_ACCEL_RING_SIZE;
+		numOfCollected++;
+	}
+
+	return numOfCollected;
+}
+
+/**
+ * \brief Hash a list of independent messages through the descriptor ring, and wait for all of them.
+ *
+ * The ring is refilled whenever jobs are finished, so the accelerator never waits for the CPU.
+ * Jobs of earlier SHA1_accelRingSubmit() calls must be collected before.
+ * Only available if the accelerator is in the system, i.e. SHA1_ACCEL_BASE is defined in "system.h".
+ *
+ * \param SHA1_accelJob_t* jobs : IN/OUT - array of jobs, m_hash is written for every job
+ * \param uint32_t numOfJobs : IN - number of jobs in the array
+ */
+void SHA1_accelRingHashJobs(SHA1_accelJob_t* jobs, uint32_t numOfJobs)
+{
+	uint32_t numOfQueued = 0;
+	uint32_t numOfCollected = 0;
+
+	while(numOfCollected < numOfJobs)
+	{
+		numOfQueued += SHA1_accelRingSubmit(&jobs[numOfQueued], numOfJobs - numOfQueued);
+		numOfCollected += SHA1_accelRingCollect();
+	}
+}
+
+#endif
+
+
+#if defined(SHA1_ARRAY)
+
+/**
+ * \brief Queue one message on the core array, the first idle core starts on it right away.
+ *
+ * The message may not be written until SHA1_arrayCollect() has returned its tag.
+ * Only available if the core array is in the system, i.e. SHA1_ARRAY_BASE is defined in "system.h".
+ *
+ * \param const void* data : IN - the message, aligned to 4 bytes, in sys_mem
+ * \param uint32_t length : IN - number of bytes in data
+ * \param uint32_t tag : IN - any value, SHA1_arrayCollect() returns it with the hash
+ * \return FALSE if the job FIFO is full: the message is not queued, collect results first
+ */
+boolean_t SHA1_arraySubmit(const void* data, uint32_t length, uint32_t tag)
+{
+	//a write to JOB_TAG would wait for a free core, and a core is only free once its result is in the result FIFO,
+	//which may be full until the CPU collects: never write it while JOB_FULL
+	if(SHA1_ARRAY.STATUS_REG & SHA1_ARRAY_STATUS_JOB_FULL)
+	{
+		return FALSE;
+	}
+
+	//the master of the array reads sys_mem, not the data cache
+	SHA1_accelFlushDataCache(data, length);
+
+	SHA1_ARRAY.JOB_SRC_REG = (alt_u32)data & ~0x80000000u;
+	SHA1_ARRAY.JOB_LENGTH_REG = length;
+	SHA1_ARRAY.JOB_TAG_REG = tag;
+
+	return TRUE;
+}
+
+/**
+ * \brief Take the oldest result of the core array, without waiting.
+ *
+ * The results come in the order the cores finish, a short message overtakes a long one queued before it.
+ * Only available if the core array is in the system, i.e. SHA1_ARRAY_BASE is defined in "system.h".
+ *
+ * \param uint32_t* tag : OUT - tag of the job, see SHA1_arraySubmit()
+ * \param uint32_t * hash_ptr : OUT - the 5 final hash words
+ * \return FALSE if no result is there
+ */
+boolean_t SHA1_arrayCollect(uint32_t* tag, uint32_t * hash_ptr)
+{
+	if(!(SHA1_ARRAY.STATUS_REG & SHA1_ARRAY_STATUS_RESULT_VALID))
+	{
+		return FALSE;
+	}
+
+	*tag = SHA1_ARRAY.RESULT_TAG_REG;
+	for(uint8_t hashIndex = 0; hashIndex < SHA1_NUM_OF_HASH_WORDS_PER_BLOCK; hashIndex++)
+	{
+		hash_ptr[hashIndex] = SHA1_ARRAY.RESULT_DIGEST_REG[hashIndex];
+	}
+	SHA1_ARRAY.RESULT_POP_REG = 1;
+
+	return TRUE;
+}
+
+/**
+ * \brief Hash a list of independent messages on the core array, and wait for all of them.
+ *
+ * The tag of each job is its index, the job FIFO is refilled whenever it has room, so no core waits for the CPU.
+ * Results of earlier SHA1_arraySubmit() calls must be collected before.
+ * Only available if the core array is in the system, i.e. SHA1_ARRAY_BASE is defined in "system.h".
+ *
+ * \param SHA1_accelJob_t* jobs : IN/OUT - array of jobs, m_hash is written for every job
+ * \param uint32_t numOfJobs : IN - number of jobs in the array
+ */
+void SHA1_arrayHashJobs(SHA1_accelJob_t* jobs, uint32_t numOfJobs)
+{
+	uint32_t numOfQueued = 0;
+	uint32_t numOfCollected = 0;
+	uint32_t tag;
+	uint32_t hash[SHA1_NUM_OF_HASH_WORDS_PER_BLOCK];
+
+	while(numOfCollected < numOfJobs)
+	{
+		while((numOfQueued < numOfJobs) &&
+				(TRUE == SHA1_arraySubmit(jobs[numOfQueued].m_data, jobs[numOfQueued].m_length, numOfQueued)))
+		{
+			numOfQueued++;
+		}
+
+		//the tag is the index of the job
+		while(TRUE == SHA1_arrayCollect(&tag, hash))
+		{
+			memcpy(jobs[tag].m_hash, hash, sizeof(hash));
+			numOfCollected++;
+		}
+	}
+}
+
+#endif
+
+
+#if defined(SHA1_POW)
+
+/**
+ * \brief Start the proof-of-work search of a job on the search engine, without waiting for it.
+ *
+ * Hashes the full blocks of the prefix on the CPU (SHA1_powPrepare()) and writes the midstate, the tail blocks,
+ * the range and the target mask. A search that is still running is stopped first.
+ * Only available if the search engine is in the system, i.e. SHA1_POW_BASE is defined in "system.h".
+ *
+ * \param const SHA1_powJob_t* job : IN - the search, only the IN members are used
+ */
+void SHA1_powEngineStart(const SHA1_powJob_t* job)
+{
+	SHA1_powTail_t tail;
+
+	SHA1_powPrepare(&tail, job->m_prefix, job->m_prefixLength);
+
+	//the other registers can only be written while the engine is not busy
+	SHA1_POW.CTRL_REG = SHA1_POW_CTRL_STOP;
+	while(SHA1_POW.CTRL_REG & SHA1_POW_STATUS_BUSY);
+
+	for(uint8_t hashIndex = 0; hashIndex < SHA1_NUM_OF_HASH_WORDS_PER_BLOCK; hashIndex++)
+	{
+		SHA1_POW.MIDSTATE_REG[hashIndex] = tail.m_midstate[hashIndex];
+		SHA1_POW.TARGET_MASK_REG[hashIndex] = job->m_targetMask[hashIndex];
+	}
+	for(uint8_t wordIndex = 0; wordIndex < (tail.m_numOfBlocks * SHA1_TOTAL_WORDS_PER_BLOCK); wordIndex++)
+	{
+		SHA1_POW.TAIL_REG[wordIndex] = tail.m_word[wordIndex];
+	}
+	SHA1_POW.NONCE_OFFSET_REG = tail.m_nonceOffset;
+	SHA1_POW.TAIL_BLOCKS_REG = tail.m_numOfBlocks;
+	SHA1_POW.NONCE_FIRST_REG = job->m_firstNonce;
+	SHA1_POW.NONCE_COUNT_REG = job->m_numOfNonces;
+
+	SHA1_POW.CTRL_REG = SHA1_POW_CTRL_START;
+}
+
+/**
+ * \brief Wait for the end of the search of SHA1_powEngineStart() and read its result.
+ *
+ * Only available if the search engine is in the system, i.e. SHA1_POW_BASE is defined in "system.h".
+ *
+ * \param SHA1_powJob_t* job : OUT - the OUT members, the same as SHA1_powSearch() writes
+ * \return TRUE if a nonce was found, the same as job->m_isFound
+ */
+boolean_t SHA1_powEngineWait(SHA1_powJob_t* job)
+{
+	uint32_t status;
+
+	do
+	{
+		status = SHA1_POW.CTRL_REG;
+	} while(!(status & SHA1_POW_STATUS_DONE));
+
+	job->m_isFound = (status & SHA1_POW_STATUS_FOUND) ? TRUE : FALSE;
+	job->m_numOfNoncesTried = SHA1_POW.NONCES_TRIED_REG;
+	job->m_nonce = 0;
+	memset(job->m_hash, 0, sizeof(job->m_hash));
+
+	if(TRUE == job->m_isFound)
+	{
+		job->m_nonce = SHA1_POW.RESULT_NONCE_REG;
+		for(uint8_t hashIndex = 0; hashIndex < SHA1_NUM_OF_HASH_WORDS_PER_BLOCK; hashIndex++)
+		{
+			job->m_hash[hashIndex] = SHA1_POW.RESULT_DIGEST_REG[hashIndex];
+		}
+	}
+
+	return job->m_isFound;
+}
+
+/**
+ * \brief SHA1_powSearch() on the search engine: SHA1_powEngineStart(), then SHA1_powEngineWait().
+ *
+ * Only available if the search engine is in the system, i.e. SHA1_POW_BASE is defined in "system.h".
+ *
+ * \param SHA1_powJob_t* job : IN/OUT - the search, the OUT members are written
+ * \return TRUE if a nonce was found, the same as job->m_isFound
+ */
+boolean_t SHA1_powEngineSearch(SHA1_powJob_t* job)
+{
+	SHA1_powEngineStart(job);
+
+	return SHA1_powEngineWait(job);
+}
+
+#endif
+
+
+#if defined(SHA1_ACCEL) || defined(SHA1_ARRAY)
+
+/**
+ * \brief Write back and invalidate the data cache lines of a memory range, like alt_dcache_flush() of the HAL.
+ *
+ * "sys/alt_cache.h" can not be included next to "led.h", which declares its own alt_u32.
+ *
+ * \param const void* start : IN - first byte of the range
+ * \param uint32_t length : IN - number of bytes
+ */
+static void SHA1_accelFlushDataCache(const void* start, uint32_t length)
+{
+	alt_u32 address = (alt_u32)start & ~(alt_u32)(NIOS2_DCACHE_LINE_SIZE - 1);
+	alt_u32 end = (alt_u32)start + length;
+
+	for(; address < end; address += NIOS2_DCACHE_LINE_SIZE)
+	{
+		__builtin_flushda((void*)address);
+	}
+}
+
+#endif
+
+
+#if defined(SHA1_ACCEL)
+
+/**
+ * \brief Write whole message words to DATA, for the active hash context of the stream mode.
+ *
+ * \param const uint8_t* bytes : IN - the message words, any alignment
+ * \param uint64_t numOfWords : IN - number of 4-byte words in bytes
+ */
+static void SHA1_accelWriteData(const uint8_t* bytes, uint64_t numOfWords)
+{
+	uint32_t word;
+
+	//the Nios II is little-endian: a word loaded from memory already has the first byte in lane 0.
+	//A write waits (waitrequest) while a complete block waits for the core.
+	if(((size_t)bytes & 3) == 0)
+	{
+		const SHA1_accelAliasedWord_t* words = (const SHA1_accelAliasedWord_t*)bytes;
+
+		for(uint64_t wordIndex = 0; wordIndex < numOfWords; wordIndex++)
+		{
+			SHA1_ACCEL.DATA_REG = words[wordIndex];
+		}
+	}
+	else
+	{
+		for(uint64_t wordIndex = 0; wordIndex < numOfWords; wordIndex++)
+		{
+			memcpy(&word, &bytes[wordIndex * 4], 4);
+			SHA1_ACCEL.DATA_REG = word;
+		}
+	}
+}
+
+/**
+ * \brief Write the end of the message to DATA_END and read its hash when the final block is done.
+ *
+ * \param uint32_t * hash_ptr : OUT - the 5 final hash words
+ * \param const uint8_t* bytes : IN - the last 0..3 bytes of the message
+ * \param uint8_t numOfTailBytes : IN - number of bytes in bytes, 0..3
+ */
+static void SHA1_accelWriteEnd(uint32_t * hash_ptr, const uint8_t* bytes, uint8_t numOfTailBytes)
+{
+	uint32_t word = 0;
+
+	//the last 0..3 bytes, the other lanes are ignored
+	memcpy(&word, bytes, numOfTailBytes);
+	SHA1_ACCEL.DATA_END_REG[numOfTailBytes] = word;
+
+	//the writes to DATA/DATA_END cleared DONE, it is set again when the final block is done
+	while(!(SHA1_ACCEL.CTRL_REG & SHA1_ACCEL_STATUS_DONE));
+
+	for(uint8_t hashIndex = 0; hashIndex < SHA1_NUM_OF_HASH_WORDS_PER_BLOCK; hashIndex++)
+	{
+		hash_ptr[hashIndex] = SHA1_ACCEL.DIGEST_REG[hashIndex];
+	}
+}
+
+#endif
@@ -0,0 +1,542 @@
+/**
+* \file   sha1_accel.h
+* \author Trung Tin Nguyen (1120436), and Dung Anh Huynh Pham (764527)
+* \date   17.10.2026
+*
+* \brief Driver of the SHA-1 accelerator, an Avalon-MM slave with the register map below
+*
+* The accelerator runs the 80 rounds of the Compression Function in 80 / ROUNDS_PER_CYCLE clock cycles,
+* SHA1_accelCompress() has the same contract as sha_1().
+*
+* SHA1_accelHashBuffer() has the same contract as SHA1_hashBuffer(): the raw message is written word by word,
+* the accelerator inserts the Padding and the length itself, there is no Pre-Processing on the CPU.
+*
+* SHA1_accelNewMessage(), SHA1_accelChainBlock() and SHA1_accelGetDigest() hash the pre-processed blocks of a
+* SHA-1 packet: the accelerator keeps the chaining value between the blocks, so a block costs 16 word writes
+* and the hash is only read once at the end of the message. The blocks go to two banks in turns, the CPU writes the
+* next block while the previous one is hashed and the core starts it on its own, so it never waits for the CPU.
+*
+* SHA1_accelSelectContext(), SHA1_accelStreamUpdate() and SHA1_accelStreamFinal() hash several raw messages at the
+* same time, e.g. a log stream and the check of a firmware image: each one has a hash context in the accelerator
+* (Padding state, bit count and chaining value), a switch is one register write. SHA1_accelSaveContext() and
+* SHA1_accelRestoreContext() spill a context to memory if there are more streams than contexts.
+*
+* SHA1_accelDmaStart() and SHA1_accelDmaWait() hash a message in memory: the accelerator reads it with its own
+* Avalon-MM master and writes the hash back, the CPU only writes the descriptor and is free in the meantime.
+*
+* SHA1_accelRingSubmit() and SHA1_accelRingCollect() queue many messages at once: the descriptors go to a ring in
+* sys_mem, the accelerator hashes one message after the other without the CPU and raises its interrupt at the end
+* of each batch. SHA1_accelRingHashJobs() does both for a whole list of messages.
+*
+* SHA1_arraySubmit(), SHA1_arrayCollect() and SHA1_arrayHashJobs() do the same on the core array, a separate
+* component (SHA1_ARRAY_BASE) with NUM_OF_CORES cores: it hashes that many messages at the same time and returns each hash
+* with the tag of its job, in the order the cores finish.
+*
+* SHA1_powEngineStart(), SHA1_powEngineWait() and SHA1_powEngineSearch() run the proof-of-work search of
+* SHA1_powSearch() on a search engine, another component (SHA1_POW_BASE): the CPU only hashes the full blocks of
+* the prefix, the engine counts the nonces and hashes the tail blocks of NUM_OF_CORES nonces at the same time.
+*
+* The RTL of the accelerator, the core array and the search engine is not in this repository, the register maps
+* below are the interface they have to implement.
+*
+* \note <notes>
+* \todo <todos>
+* \warning The accelerator is not part of base_sys.qsys yet. Without it, there is no
+*          SHA1_ACCEL_BASE in system.h and SHA1_COMPRESSION_AVALON_ACCEL can not be selected.
+*
+*  Changelog:\n
+*  - <version; data of change; author>
+*            - <description of the change>
+*
+* \copyright Copyright 2023
+* Department of electrical engineering and information technology, Hochschule Darmstadt - University of applied sciences (h_da). All Rights Reserved.
+* Permission to use, copy, modify, and distribute this software and its documentation for educational, and research purposes in the context of non-commercial
+* (unless permitted by h_da) and official h_da projects, is hereby granted for enrolled students of h_da, provided that the above copyright notice,
+* this paragraph and the following paragraph appear in all copies, modifications, and distributions.
+*
+* Contact Prof.Dr. C. Jakob, christian.jakob@h-da.de, Birkenweg 8 64295 Darmstadt - GERMANY for commercial requests.
+*
+* \warning This software is a PROTOTYPE version and is not designed or intended for use in production, especially not for safety-critical applications!
+* The user represents and warrants that it will NOT use or redistribute the Software for such purposes.
+* This prototype is for research purposes only. This software is provided "AS IS," without a warranty of any kind.
+**/
+
+#ifndef MYCODE_SHA1_ACCEL_H_
+#define MYCODE_SHA1_ACCEL_H_
+
+#include "global.h"
+#include "platform.h"
+#include "sha1.h"
+
+
+/*****************************************************************************/
+/* Global pre-processor symbols/macros and type declarations                 */
+/*****************************************************************************/
+
+//word offsets of the registers
+#define SHA1_ACCEL_REG_CTRL			0x00	/**< W: START, R: BUSY and DONE */
+#define SHA1_ACCEL_REG_CYCLES		0x01	/**< R: clock cycles of the last block */
+#define SHA1_ACCEL_REG_CONFIG		0x02	/**< R: parameters of the hardware */
+#define SHA1_ACCEL_REG_DATA			0x03	/**< W: next 4 raw message bytes */
+#define SHA1_ACCEL_REG_DATA_END		0x04	/**< W: 4 words, DATA_END[n] ends the message with its last n bytes */
+#define SHA1_ACCEL_REG_HASH_IN		0x08	/**< R/W: 5 words, prev_hash of sha_1() */
+#define SHA1_ACCEL_REG_IRQ_STATUS	0x0D	/**< R/W: interrupt sources, write 1 to clear */
+#define SHA1_ACCEL_REG_IRQ_ENABLE	0x0E	/**< R/W: the interrupt line is high while IRQ_STATUS & IRQ_ENABLE != 0 */
+#define SHA1_ACCEL_REG_DIGEST		0x10	/**< R: 5 words, hash_ptr of sha_1() */
+#define SHA1_ACCEL_REG_CONTEXT_ID	0x15	/**< R/W: active hash context of the stream mode, a write switches */
+#define SHA1_ACCEL_REG_CONTEXT_INDEX	0x16	/**< R/W: word of the active context that CONTEXT_DATA accesses next */
+#define SHA1_ACCEL_REG_CONTEXT_DATA	0x17	/**< R/W: word CONTEXT_INDEX of the active context, then CONTEXT_INDEX + 1 */
+#define SHA1_ACCEL_REG_DMA_SRC		0x18	/**< R/W: byte address of the message, aligned to 4 bytes */
+#define SHA1_ACCEL_REG_DMA_LENGTH	0x19	/**< R/W: length of the message in bytes */
+#define SHA1_ACCEL_REG_DMA_DST		0x1A	/**< R/W: byte address of the 5 hash words, aligned to 4 bytes */
+#define SHA1_ACCEL_REG_RING_BASE	0x1C	/**< R/W: byte address of the descriptor ring, aligned to 16 bytes */
+#define SHA1_ACCEL_REG_RING_SIZE	0x1D	/**< R/W: number of descriptors, a write empties the ring */
+#define SHA1_ACCEL_REG_RING_HEAD	0x1E	/**< R/W: index after the last descriptor written by the CPU */
+#define SHA1_ACCEL_REG_RING_TAIL	0x1F	/**< R: index after the last descriptor whose hash is in memory */
+#define SHA1_ACCEL_REG_MESSAGE		0x20	/**< R/W: 16 words, the pre-processed 512-bit block */
+#define SHA1_ACCEL_REG_CHAIN_MESSAGE	0x30	/**< W: 16 words, two banks in turns, word 15 queues a chained block */
+#define SHA1_ACCEL_NUM_OF_REGS		0x40	/**< span of the slave, in words */
+
+//bits of the CTRL register
+#define SHA1_ACCEL_CTRL_START		(1u << 0)	/**< write 1 to start, ignored while busy */
+#define SHA1_ACCEL_CTRL_NEW_MESSAGE	(1u << 1)	/**< write 1: the next chained block starts from the initial hash */
+#define SHA1_ACCEL_CTRL_DMA_START	(1u << 2)	/**< write 1: hash the message at DMA_SRC, ignored while DMA is busy */
+#define SHA1_ACCEL_STATUS_BUSY		(1u << 0)	/**< the core is running */
+#define SHA1_ACCEL_STATUS_DONE		(1u << 1)	/**< DIGEST holds the result of the last START or message */
+#define SHA1_ACCEL_STATUS_DMA_BUSY	(1u << 2)	/**< the DMA master works on a message or on the ring */
+#define SHA1_ACCEL_STATUS_CHAIN_FULL	(1u << 3)	/**< both CHAIN_MESSAGE banks are full, the next write waits */
+
+//bits of the IRQ_STATUS and IRQ_ENABLE registers
+#define SHA1_ACCEL_IRQ_RING			(1u << 0)	/**< a ring descriptor with SHA1_ACCEL_DESCRIPTOR_FLAG_IRQ is done */
+
+//bits of the FLAGS word of a descriptor
+#define SHA1_ACCEL_DESCRIPTOR_FLAG_IRQ	(1u << 0)	/**< set SHA1_ACCEL_IRQ_RING when the hash is in memory */
+
+//number of descriptors of the ring of the driver, one of them always stays free
+#ifndef SHA1_ACCEL_RING_SIZE
+#define SHA1_ACCEL_RING_SIZE		32
+#endif
+
+//fields of the CONFIG register
+#define SHA1_ACCEL_CONFIG_ROUNDS_PER_CYCLE(config)	((config) & 0xFFu)	/**< 1, 2, 4, 5, 10 or 20 */
+#define SHA1_ACCEL_CONFIG_NUM_OF_CONTEXTS(config)	(((config) >> 8) & 0xFFu)	/**< hash contexts, 1 to 16 */
+
+//words of a hash context, read and written through CONTEXT_DATA
+#define SHA1_ACCEL_CONTEXT_WORD_BLOCK		0	/**< 16 words: the block so far, big-endian, 0 from the word index on */
+#define SHA1_ACCEL_CONTEXT_WORD_HASH		16	/**< 5 words: chaining value from the second block on */
+#define SHA1_ACCEL_CONTEXT_WORD_BIT_COUNT	21	/**< 2 words: bits of the message so far, low word first */
+#define SHA1_ACCEL_CONTEXT_WORD_FLAGS		23	/**< word index in bits 3..0 and SHA1_ACCEL_CONTEXT_FLAG_FIRST */
+#define SHA1_ACCEL_CONTEXT_NUM_OF_WORDS		24
+#define SHA1_ACCEL_CONTEXT_FLAG_FIRST		(1u << 4)	/**< the next block is the first one of a message */
+
+//word offsets of the registers of the core array
+#define SHA1_ARRAY_REG_STATUS		0x0		/**< R: BUSY, RESULT_VALID and JOB_FULL */
+#define SHA1_ARRAY_REG_CONFIG		0x1		/**< R: parameters of the hardware */
+#define SHA1_ARRAY_REG_JOB_SRC		0x2		/**< R/W: byte address of the message, aligned to 4 bytes */
+#define SHA1_ARRAY_REG_JOB_LENGTH	0x3		/**< R/W: length of the message in bytes */
+#define SHA1_ARRAY_REG_JOB_TAG		0x4		/**< W: tag of the job, the write queues JOB_SRC, JOB_LENGTH and the tag */
+#define SHA1_ARRAY_REG_RESULT_TAG	0x5		/**< R: tag of the oldest result */
+#define SHA1_ARRAY_REG_RESULT_DIGEST	0x6		/**< R: 5 words, the hash of the oldest result */
+#define SHA1_ARRAY_REG_RESULT_POP	0xB		/**< W: any value, removes the oldest result */
+#define SHA1_ARRAY_REG_IRQ_ENABLE	0xC		/**< R/W: the interrupt line is high while RESULT_VALID */
+#define SHA1_ARRAY_NUM_OF_REGS		0x10	/**< span of the slave, in words */
+
+//bits of the STATUS register of the core array
+#define SHA1_ARRAY_STATUS_BUSY			(1u << 0)	/**< a job is queued or on a core */
+#define SHA1_ARRAY_STATUS_RESULT_VALID	(1u << 1)	/**< RESULT_TAG and RESULT_DIGEST hold the oldest result */
+#define SHA1_ARRAY_STATUS_JOB_FULL		(1u << 2)	/**< the job FIFO is full, a write to JOB_TAG waits for a free core */
+
+//fields of the CONFIG register of the core array
+#define SHA1_ARRAY_CONFIG_ROUNDS_PER_CYCLE(config)	((config) & 0xFFu)	/**< of each core: 1, 2, 4, 5, 10 or 20 */
+#define SHA1_ARRAY_CONFIG_NUM_OF_CORES(config)	(((config) >> 8) & 0xFFu)	/**< 1 to 16 */
+
+//word offsets of the registers of the proof-of-work search engine
+#define SHA1_POW_REG_CTRL			0x00	/**< W: START and STOP, R: BUSY, DONE and FOUND */
+#define SHA1_POW_REG_CONFIG			0x01	/**< R: parameters of the hardware */
+#define SHA1_POW_REG_NONCE_FIRST	0x02	/**< R/W: first nonce of the range */
+#define SHA1_POW_REG_NONCE_COUNT	0x03	/**< R/W: number of nonces of the range */
+#define SHA1_POW_REG_NONCE_OFFSET	0x04	/**< R/W: byte offset of the nonce characters in TAIL */
+#define SHA1_POW_REG_TAIL_BLOCKS	0x05	/**< R/W: 1 or 2 tail blocks per nonce */
+#define SHA1_POW_REG_IRQ_ENABLE		0x06	/**< R/W: the interrupt line is high while DONE */
+#define SHA1_POW_REG_RESULT_NONCE	0x07	/**< R: the first nonce that meets the target */
+#define SHA1_POW_REG_NONCES_TRIED	0x08	/**< R: nonces compared since START */
+#define SHA1_POW_REG_CYCLES			0x09	/**< R: clock cycles from START to DONE */
+#define SHA1_POW_REG_MIDSTATE		0x0A	/**< R/W: 5 words, the hash words after the full blocks of the prefix */
+#define SHA1_POW_REG_TARGET_MASK	0x10	/**< R/W: 5 words, bits of the hash that must be 0 */
+#define SHA1_POW_REG_RESULT_DIGEST	0x18	/**< R: 5 words, the hash of the stamp of RESULT_NONCE */
+#define SHA1_POW_REG_TAIL			0x20	/**< R/W: 32 words, the pre-processed tail blocks */
+#define SHA1_POW_NUM_OF_REGS		0x40	/**< span of the slave, in words */
+
+//bits of the CTRL register of the proof-of-work search engine
+#define SHA1_POW_CTRL_START			(1u << 0)	/**< write 1 to start the search, ignored while busy */
+#define SHA1_POW_CTRL_STOP			(1u << 1)	/**< write 1 to end the search after the nonces on the cores */
+#define SHA1_POW_STATUS_BUSY		(1u << 0)	/**< the search is running */
+#define SHA1_POW_STATUS_DONE		(1u << 1)	/**< the search has ended */
+#define SHA1_POW_STATUS_FOUND		(1u << 2)	/**< RESULT_NONCE and RESULT_DIGEST hold the first hit */
+
+//fields of the CONFIG register of the proof-of-work search engine
+#define SHA1_POW_CONFIG_ROUNDS_PER_CYCLE(config)	((config) & 0xFFu)	/**< of each core: 1, 2, 4, 5, 10 or 20 */
+#define SHA1_POW_CONFIG_NUM_OF_CORES(config)	(((config) >> 8) & 0xFFu)	/**< nonces at the same time, 1 to 16 */
+
+//SHA-1 accelerator unit structure
+typedef struct {
+	__IO alt_u32 CTRL_REG;
+	__I  alt_u32 CYCLES_REG;
+	__I  alt_u32 CONFIG_REG;
+	__O  alt_u32 DATA_REG;
+	__O  alt_u32 DATA_END_REG[4];
+	__IO alt_u32 HASH_IN_REG[5];
+	__IO alt_u32 IRQ_STATUS_REG;
+	__IO alt_u32 IRQ_ENABLE_REG;
+	     alt_u32 RESERVED_1[SHA1_ACCEL_REG_DIGEST - SHA1_ACCEL_REG_IRQ_ENABLE - 1];
+	__I  alt_u32 DIGEST_REG[5];
+	__IO alt_u32 CONTEXT_ID_REG;
+	__IO alt_u32 CONTEXT_INDEX_REG;
+	__IO alt_u32 CONTEXT_DATA_REG;
+	__IO alt_u32 DMA_SRC_REG;
+	__IO alt_u32 DMA_LENGTH_REG;
+	__IO alt_u32 DMA_DST_REG;
+	     alt_u32 RESERVED_3[SHA1_ACCEL_REG_RING_BASE - SHA1_ACCEL_REG_DMA_DST - 1];
+	__IO alt_u32 RING_BASE_REG;
+	__IO alt_u32 RING_SIZE_REG;
+	__IO alt_u32 RING_HEAD_REG;
+	__I  alt_u32 RING_TAIL_REG;
+	__IO alt_u32 MESSAGE_REG[16];
+	__O  alt_u32 CHAIN_MESSAGE_REG[16];
+} SHA1_ACCEL_TYPE;
+
+//SHA-1 core array unit structure
+typedef struct {
+	__I  alt_u32 STATUS_REG;
+	__I  alt_u32 CONFIG_REG;
+	__IO alt_u32 JOB_SRC_REG;
+	__IO alt_u32 JOB_LENGTH_REG;
+	__O  alt_u32 JOB_TAG_REG;
+	__I  alt_u32 RESULT_TAG_REG;
+	__I  alt_u32 RESULT_DIGEST_REG[5];
+	__O  alt_u32 RESULT_POP_REG;
+	__IO alt_u32 IRQ_ENABLE_REG;
+} SHA1_ARRAY_TYPE;
+
+//SHA-1 proof-of-work search engine unit structure
+typedef struct {
+	__IO alt_u32 CTRL_REG;
+	__I  alt_u32 CONFIG_REG;
+	__IO alt_u32 NONCE_FIRST_REG;
+	__IO alt_u32 NONCE_COUNT_REG;
+	__IO alt_u32 NONCE_OFFSET_REG;
+	__IO alt_u32 TAIL_BLOCKS_REG;
+	__IO alt_u32 IRQ_ENABLE_REG;
+	__I  alt_u32 RESULT_NONCE_REG;
+	__I  alt_u32 NONCES_TRIED_REG;
+	__I  alt_u32 CYCLES_REG;
+	__IO alt_u32 MIDSTATE_REG[5];
+	     alt_u32 RESERVED_1[SHA1_POW_REG_TARGET_MASK - SHA1_POW_REG_MIDSTATE - 5];
+	__IO alt_u32 TARGET_MASK_REG[5];
+	     alt_u32 RESERVED_2[SHA1_POW_REG_RESULT_DIGEST - SHA1_POW_REG_TARGET_MASK - 5];
+	__I  alt_u32 RESULT_DIGEST_REG[5];
+	     alt_u32 RESERVED_3[SHA1_POW_REG_TAIL - SHA1_POW_REG_RESULT_DIGEST - 5];
+	__IO alt_u32 TAIL_REG[32];
+} SHA1_POW_TYPE;
+
+//descriptor of one message in the ring, read by the DMA master of the accelerator
+typedef struct {
+	alt_u32 SRC_ADDRESS;	/**< byte address of the message, aligned to 4 bytes */
+	alt_u32 LENGTH;			/**< length of the message in bytes */
+	alt_u32 DST_ADDRESS;	/**< byte address of the 5 hash words, aligned to 4 bytes */
+	alt_u32 FLAGS;			/**< SHA1_ACCEL_DESCRIPTOR_FLAG_* */
+} SHA1_ACCEL_DESCRIPTOR_TYPE;
+
+/**
+ * \brief One message of the descriptor ring and its final hash.
+ */
+struct sSHA1_accelJob {
+  const void*	m_data;										/**< IN - the message, aligned to 4 bytes, in sys_mem */
+  uint32_t		m_length;									/**< IN - length of the message, in bytes */
+  uint32_t		m_hash[SHA1_NUM_OF_HASH_WORDS_PER_BLOCK];	/**< OUT - the 5 final hash words */
+};
+typedef struct sSHA1_accelJob SHA1_accelJob_t;
+
+/**
+ * \brief A hash context spilled to memory, the words of CONTEXT_DATA.
+ */
+struct sSHA1_accelContext {
+  uint32_t		m_word[SHA1_ACCEL_CONTEXT_NUM_OF_WORDS];	/**< SHA1_ACCEL_CONTEXT_WORD_* */
+};
+typedef struct sSHA1_accelContext SHA1_accelContext_t;
+
+#if defined(__nios2__) && defined(SHA1_ACCEL_BASE)
+//Base address of the accelerator SHA1_ACCEL_BASE in "system.h"
+//MSB is set to one to bypass the data cache
+#define SHA1_ACCEL (*((SHA1_ACCEL_TYPE *) (SHA1_ACCEL_BASE | 0x80000000u)))
+#endif
+
+#if defined(__nios2__) && defined(SHA1_ARRAY_BASE)
+//Base address of the core array SHA1_ARRAY_BASE in "system.h"
+//MSB is set to one to bypass the data cache
+#define SHA1_ARRAY (*((SHA1_ARRAY_TYPE *) (SHA1_ARRAY_BASE | 0x80000000u)))
+#endif
+
+#if defined(__nios2__) && defined(SHA1_POW_BASE)
+//Base address of the proof-of-work search engine SHA1_POW_BASE in "system.h"
+//MSB is set to one to bypass the data cache
+#define SHA1_POW (*((SHA1_POW_TYPE *) (SHA1_POW_BASE | 0x80000000u)))
+#endif
+
+
+/*****************************************************************************/
+/* API functions                                                             */
+/*****************************************************************************/
+
+/**
+ * \brief Compression Function on the SHA-1 accelerator.
+ *
+ * Writes the block and the chaining value into the registers, starts the core and polls DONE.
+ * hash_ptr may point to the same array as prev_hash.
+ * Only available if the accelerator is in the system, i.e. SHA1_ACCEL_BASE is defined in "system.h".
+ *
+ * \param uint32_t * hash_ptr : OUT - pointer to the processed hash
+ * \param const uint32_t * message : IN - the pre-processed 512-bit wide input message
+ * \param const uint32_t * prev_hash : IN - pointer to the initial hash
+ */
+void SHA1_accelCompress(uint32_t * hash_ptr, const uint32_t * message, const uint32_t * prev_hash);
+
+/**
+ * \brief Hash a whole message on the SHA-1 accelerator, without Pre-Processing on the CPU.
+ *
+ * The bytes are written to DATA in memory order (byte lane 0 first), the last 0..3 bytes to DATA_END.
+ * The accelerator counts the length, inserts the Padding and chains the blocks, the CPU only polls DONE at the end.
+ * Only available if the accelerator is in the system, i.e. SHA1_ACCEL_BASE is defined in "system.h".
+ *
+ * \param uint32_t * hash_ptr : OUT - the 5 final hash words
+ * \param const void* data : IN - the message, any alignment, may contain '\0'
+ * \param uint64_t length : IN - number of bytes in data
+ */
+void SHA1_accelHashBuffer(uint32_t * hash_ptr, const void* data, uint64_t length);
+
+/**
+ * \brief Empty all hash contexts and set HASH_IN to the initial hash, before the first SHA1_accelStreamUpdate().
+ *
+ * Context 0 is active afterwards. SHA1_accelHashBuffer() uses the active context, too, it must be empty then.
+ * Only available if the accelerator is in the system, i.e. SHA1_ACCEL_BASE is defined in "system.h".
+ *
+ * \return the number of hash contexts of the accelerator
+ */
+uint32_t SHA1_accelContextInit(void);
+
+/**
+ * \brief Switch the stream mode to another hash context, one register write.
+ *
+ * The write waits (waitrequest) until the blocks of the active context are done, then the accelerator saves it
+ * and loads the other one in the same clock cycle.
+ * Only available if the accelerator is in the system, i.e. SHA1_ACCEL_BASE is defined in "system.h".
+ *
+ * \param uint32_t contextId : IN - 0 .. SHA1_accelContextInit() - 1
+ */
+void SHA1_accelSelectContext(uint32_t contextId);
+
+/**
+ * \brief Add the next part of the message of the active hash context.
+ *
+ * Only available if the accelerator is in the system, i.e. SHA1_ACCEL_BASE is defined in "system.h".
+ *
+ * \param const void* data : IN - the next bytes of the message, any alignment
+ * \param uint32_t length : IN - number of bytes in data, a multiple of 4: only the end of a message may have a part of a word
+ */
+void SHA1_accelStreamUpdate(const void* data, uint32_t length);
+
+/**
+ * \brief Add the last part of the message of the active hash context and read its hash.
+ *
+ * The context is empty afterwards, ready for the next message.
+ * Only available if the accelerator is in the system, i.e. SHA1_ACCEL_BASE is defined in "system.h".
+ *
+ * \param uint32_t * hash_ptr : OUT - the 5 final hash words
+ * \param const void* data : IN - the last bytes of the message, any alignment
+ * \param uint32_t length : IN - number of bytes in data, any number
+ */
+void SHA1_accelStreamFinal(uint32_t * hash_ptr, const void* data, uint32_t length);
+
+/**
+ * \brief Copy the active hash context to memory, to free its slot for another stream.
+ *
+ * Only available if the accelerator is in the system, i.e. SHA1_ACCEL_BASE is defined in "system.h".
+ *
+ * \param SHA1_accelContext_t* context : OUT - the state of the message of the active context
+ */
+void SHA1_accelSaveContext(SHA1_accelContext_t* context);
+
+/**
+ * \brief Replace the active hash context with one from memory, saved by SHA1_accelSaveContext().
+ *
+ * Only available if the accelerator is in the system, i.e. SHA1_ACCEL_BASE is defined in "system.h".
+ *
+ * \param const SHA1_accelContext_t* context : IN - the state of the message
+ */
+void SHA1_accelRestoreContext(const SHA1_accelContext_t* context);
+
+/**
+ * \brief Start a new message in the chained mode: the next block starts from the initial hash.
+ *
+ * Drops the result of a block that is still running.
+ * Only available if the accelerator is in the system, i.e. SHA1_ACCEL_BASE is defined in "system.h".
+ */
+void SHA1_accelNewMessage(void);
+
+/**
+ * \brief Hash the next pre-processed block of the message, chained to the previous one inside the accelerator.
+ *
+ * Only writes the 16 words to the free bank and returns, the core starts the block as soon as the previous one
+ * is done. The writes only wait (waitrequest) while both banks are full, i.e. two blocks wait for the core.
+ * Only available if the accelerator is in the system, i.e. SHA1_ACCEL_BASE is defined in "system.h".
+ *
+ * \param const uint32_t * message : IN - the pre-processed 512-bit wide input message
+ */
+void SHA1_accelChainBlock(const uint32_t * message);
+
+/**
+ * \brief Wait for the last chained block and read the hash of the message.
+ *
+ * Only available if the accelerator is in the system, i.e. SHA1_ACCEL_BASE is defined in "system.h".
+ *
+ * \param uint32_t * hash_ptr : OUT - the 5 hash words after the last block
+ */
+void SHA1_accelGetDigest(uint32_t * hash_ptr);
+
+/**
+ * \brief Start hashing a message in memory with the DMA master of the accelerator, without waiting for it.
+ *
+ * The accelerator reads the message from memory itself, through the second port of sys_mem, and writes the hash
+ * into a buffer of the driver when it is done. The CPU does not touch the message and may do other work,
+ * SHA1_accelDmaWait() waits for the end. The message may not be written until then.
+ * Only available if the accelerator is in the system, i.e. SHA1_ACCEL_BASE is defined in "system.h".
+ *
+ * \param const void* data : IN - the message, aligned to 4 bytes, in sys_mem
+ * \param uint32_t length : IN - number of bytes in data
+ */
+void SHA1_accelDmaStart(const void* data, uint32_t length);
+
+/**
+ * \brief Wait until the accelerator has written the hash of SHA1_accelDmaStart() into memory, and copy it.
+ *
+ * Only available if the accelerator is in the system, i.e. SHA1_ACCEL_BASE is defined in "system.h".
+ *
+ * \param uint32_t * hash_ptr : OUT - the 5 final hash words
+ */
+void SHA1_accelDmaWait(uint32_t * hash_ptr);
+
+/**
+ * \brief Set up the descriptor ring of the driver and empty it.
+ *
+ * The ring has SHA1_ACCEL_RING_SIZE descriptors and one hash buffer of a data cache line per descriptor.
+ * Jobs that are still queued are dropped.
+ * Only available if the accelerator is in the system, i.e. SHA1_ACCEL_BASE is defined in "system.h".
+ *
+ * \param boolean_t isIrqEnabled : IN - TRUE: the interrupt line of the accelerator goes high at the end of a batch
+ */
+void SHA1_accelRingInit(boolean_t isIrqEnabled);
+
+/**
+ * \brief Queue a batch of messages in the descriptor ring, the accelerator starts on them right away.
+ *
+ * Queues as many jobs as there are free descriptors, the last one of them gets the IRQ flag. RING_HEAD is written
+ * once for the whole batch. The messages may not be written until SHA1_accelRingCollect() has returned their jobs.
+ * Only available if the accelerator is in the system, i.e. SHA1_ACCEL_BASE is defined in "system.h".
+ *
+ * \param SHA1_accelJob_t* jobs : IN - array of jobs, must stay valid until they are collected
+ * \param uint32_t numOfJobs : IN - number of jobs in the array
+ * \return number of jobs queued, from the start of the array, 0 if the ring is full
+ */
+uint32_t SHA1_accelRingSubmit(SHA1_accelJob_t* jobs, uint32_t numOfJobs);
+
+/**
+ * \brief Copy the hashes of the jobs the accelerator has finished into their m_hash, without waiting.
+ *
+ * Clears the interrupt of the ring, so it may be called from the interrupt handler.
+ * Only available if the accelerator is in the system, i.e. SHA1_ACCEL_BASE is defined in "system.h".
+ *
+ * \return number of jobs finished since the last call, in the order they were queued
+ */
+uint32_t SHA1_accelRingCollect(void);
+
+/**
+ * \brief Hash a list of independent messages through the descriptor ring, and wait for all of them.
+ *
+ * The ring is refilled whenever jobs are finished, so the accelerator never waits for the CPU.
+ * Jobs of earlier SHA1_accelRingSubmit() calls must be collected before.
+ * Only available if the accelerator is in the system, i.e. SHA1_ACCEL_BASE is defined in "system.h".
+ *
+ * \param SHA1_accelJob_t* jobs : IN/OUT - array of jobs, m_hash is written for every job
+ * \param uint32_t numOfJobs : IN - number of jobs in the array
+ */
+void SHA1_accelRingHashJobs(SHA1_accelJob_t* jobs, uint32_t numOfJobs);
+
+/**
+ * \brief Queue one message on the core array, the first idle core starts on it right away.
+ *
+ * The message may not be written until SHA1_arrayCollect() has returned its tag.
+ * Only available if the core array is in the system, i.e. SHA1_ARRAY_BASE is defined in "system.h".
+ *
+ * \param const void* data : IN - the message, aligned to 4 bytes, in sys_mem
+ * \param uint32_t length : IN - number of bytes in data
+ * \param uint32_t tag : IN - any value, SHA1_arrayCollect() returns it with the hash
+ * \return FALSE if the job FIFO is full: the message is not queued, collect results first
+ */
+boolean_t SHA1_arraySubmit(const void* data, uint32_t length, uint32_t tag);
+
+/**
+ * \brief Take the oldest result of the core array, without waiting.
+ *
+ * The results come in the order the cores finish, a short message overtakes a long one queued before it.
+ * Only available if the core array is in the system, i.e. SHA1_ARRAY_BASE is defined in "system.h".
+ *
+ * \param uint32_t* tag : OUT - tag of the job, see SHA1_arraySubmit()
+ * \param uint32_t * hash_ptr : OUT - the 5 final hash words
+ * \return FALSE if no result is there
+ */
+boolean_t SHA1_arrayCollect(uint32_t* tag, uint32_t * hash_ptr);
+
+/**
+ * \brief Hash a list of independent messages on the core array, and wait for all of them.
+ *
+ * The tag of each job is its index, the job FIFO is refilled whenever it has room, so no core waits for the CPU.
+ * Results of earlier SHA1_arraySubmit() calls must be collected before.
+ * Only available if the core array is in the system, i.e. SHA1_ARRAY_BASE is defined in "system.h".
+ *
+ * \param SHA1_accelJob_t* jobs : IN/OUT - array of jobs, m_hash is written for every job
+ * \param uint32_t numOfJobs : IN - number of jobs in the array
+ */
+void SHA1_arrayHashJobs(SHA1_accelJob_t* jobs, uint32_t numOfJobs);
+
+/**
+ * \brief Start the proof-of-work search of a job on the search engine, without waiting for it.
+ *
+ * Hashes the full blocks of the prefix on the CPU (SHA1_powPrepare()) and writes the midstate, the tail blocks,
+ * the range and the target mask. A search that is still running is stopped first.
+ * Only available if the search engine is in the system, i.e. SHA1_POW_BASE is defined in "system.h".
+ *
+ * \param const SHA1_powJob_t* job : IN - the search, only the IN members are used
+ */
+void SHA1_powEngineStart(const SHA1_powJob_t* job);
+
+/**
+ * \brief Wait for the end of the search of SHA1_powEngineStart() and read its result.
+ *
+ * Only available if the search engine is in the system, i.e. SHA1_POW_BASE is defined in "system.h".
+ *
+ * \param SHA1_powJob_t* job : OUT - the OUT members, the same as SHA1_powSearch() writes
+ * \return TRUE if a nonce was found, the same as job->m_isFound
+ */
+boolean_t SHA1_powEngineWait(SHA1_powJob_t* job);
+
+/**
+ * \brief SHA1_powSearch() on the search engine: SHA1_powEngineStart(), then SHA1_powEngineWait().
+ *
+ * Only available if the search engine is in the system, i.e. SHA1_POW_BASE is defined in "system.h".
+ *
+ * \param SHA1_powJob_t* job : IN/OUT - the search, the OUT members are written
+ * \return TRUE if a nonce was found, the same as job->m_isFound
+ */
+boolean_t SHA1_powEngineSearch(SHA1_powJob_t* job);
+
+#endif /* MYCODE_SHA1_ACCEL_H_ */
@@ -0,0 +1,117 @@
+/**
+* \file   sha1_ci.c
+* \author Trung Tin Nguyen (1120436), and Dung Anh Huynh Pham (764527)
+* \date   17.10.2026
+*
+* \brief C model of the SHA-1 round step custom instruction
+*
+* \copyright Copyright 2023
+* Department of electrical engineering and information technology, Hochschule Darmstadt - University of applied sciences (h_da). All Rights Reserved.
+* Permission to use, copy, modify, and distribute this software and its documentation for educational, and research purposes in the context of non-commercial
+* (unless permitted by h_da) and official h_da projects, is hereby granted for enrolled students of h_da, provided that the above copyright notice,
+* this paragraph and the following paragraph appear in all copies, modifications, and distributions.
+*
+* Contact Prof.Dr. C. Jakob, christian.jakob@h-da.de, Birkenweg 8 64295 Darmstadt - GERMANY for commercial requests.
+*
+* \warning This software is a PROTOTYPE version and is not designed or intended for use in production, especially not for safety-critical applications!
+* The user represents and warrants that it will NOT use or redistribute the Software for such purposes.
+* This prototype is for research purposes only. This software is provided "AS IS," without a warranty of any kind.
+*/
+
+
+/*****************************************************************************/
+/* Include files                                                             */
+/*****************************************************************************/
+#include "sha1.h"
+#include "sha1_ci.h"
+#include "sha1_rounds.h"
+
+
+/*****************************************************************************/
+/* Local variable definitions ('static')                                     */
+/*****************************************************************************/
+
+/**
+ * \brief The hash words A..E of the instruction, one set per CPU: per thread on the host.
+ */
+#if defined(__nios2__)
+static uint32_t SHA1_ciHash[SHA1_NUM_OF_HASH_WORDS_PER_BLOCK];
+#else
+static __thread uint32_t SHA1_ciHash[SHA1_NUM_OF_HASH_WORDS_PER_BLOCK];
+#endif
+
+
+/*****************************************************************************/
+/* Function implementation - global ('extern') and local ('static')          */
+/*****************************************************************************/
+
+/**
+ * \brief C model of one custom instruction, bit for bit the behaviour of the hardware.
+ *
+ * Works on the hash words of the calling thread.
+ *
+ * \param uint32_t op : IN - SHA1_CI_OP_*, the n field
+ * \param uint32_t dataa : IN - first operand
+ * \param uint32_t datab : IN - second operand
+ * \return the result of the instruction: the new A of a round, the sum of SHA1_CI_OP_ADD, 0 for the loads
+ */
+uint32_t SHA1_ciModel(uint32_t op, uint32_t dataa, uint32_t datab)
+{
+	uint32_t* hash = SHA1_ciHash;
+	uint32_t kernel;
+	uint32_t constantK;
+	uint32_t hashIndex;
+	uint32_t result;
+
+	switch(op % SHA1_CI_NUM_OF_OPS)
+	{
+		case SHA1_CI_OP_LOAD_AB:
+			hash[SHA1_HASH_A] = dataa;
+			hash[SHA1_HASH_B] = datab;
+			return 0;
+
+		case SHA1_CI_OP_LOAD_CD:
+			hash[SHA1_HASH_C] = dataa;
+			hash[SHA1_HASH_D] = datab;
+			return 0;
+
+		case SHA1_CI_OP_LOAD_E:
+			hash[SHA1_HASH_E] = dataa;
+			return 0;
+
+		case SHA1_CI_OP_ADD:
+			//the hardware decodes the 3 low-order bits of dataa, 5 .. 7 select A like 0
+			hashIndex = dataa & 7u;
+			return hash[(hashIndex < SHA1_NUM_OF_HASH_WORDS_PER_BLOCK) ? hashIndex : SHA1_HASH_A] + datab;
+
+		case SHA1_CI_OP_ROUND_STAGE_1:
+			kernel = SHA1_KERNEL_CH(hash[SHA1_HASH_B], hash[SHA1_HASH_C], hash[SHA1_HASH_D]);
+			constantK = SHA1_K_STAGE_1;
+			break;
+
+		case SHA1_CI_OP_ROUND_STAGE_2:
+			kernel = SHA1_KERNEL_PARITY(hash[SHA1_HASH_B], hash[SHA1_HASH_C], hash[SHA1_HASH_D]);
+			constantK = SHA1_K_STAGE_2;
+			break;
+
+		case SHA1_CI_OP_ROUND_STAGE_3:
+			kernel = SHA1_KERNEL_MAJ(hash[SHA1_HASH_B], hash[SHA1_HASH_C], hash[SHA1_HASH_D]);
+			constantK = SHA1_K_STAGE_3;
+			break;
+
+		default:
+			kernel = SHA1_KERNEL_PARITY(hash[SHA1_HASH_B], hash[SHA1_HASH_C], hash[SHA1_HASH_D]);
+			constantK = SHA1_K_STAGE_4;
+			break;
+	}
+
+	//one round, datab is not used
+	result = SHA1_ROTL32(hash[SHA1_HASH_A], 5) + kernel + hash[SHA1_HASH_E] + constantK + dataa;
+	hash[SHA1_HASH_E] = hash[SHA1_HASH_D];
+	hash[SHA1_HASH_D] = hash[SHA1_HASH_C];
+	hash[SHA1_HASH_C] = SHA1_ROTL32(hash[SHA1_HASH_B], 30);
+	hash[SHA1_HASH_B] = hash[SHA1_HASH_A];
+	hash[SHA1_HASH_A] = result;
+
+	return result;
+}
@@ -0,0 +1,104 @@
+/**
+* \file   sha1_ci.h
+* \author Trung Tin Nguyen (1120436), and Dung Anh Huynh Pham (764527)
+* \date   17.10.2026
+*
+* \brief SHA-1 round step custom instruction of the Nios II, and its C model
+*
+* A Nios II custom instruction has two 32-bit operands and one result, too few for a round: it needs the 5 hash
+* words, W[t] and K. So the instruction keeps the hash words A..E in its own registers, the CPU loads them at the
+* start of a block, then one instruction per round gives W[t] in a CPU register and the stage in the n field (K and
+* the kernel function), and at the end 5 instructions add the hash words to prev_hash. One block costs
+* 3 + 80 + 5 instructions plus the message schedule, instead of about 10 ALU instructions per round.
+*
+* On the Nios II with the instruction in base_sys.qsys, SHA1_CI_WRITE() and SHA1_CI_READ() are __builtin_custom_nii()
+* and __builtin_custom_inii(). Everywhere else they call SHA1_ciModel(), which does the same bit for bit, so
+* SHA1_compressCustomInstr() of "sha1.c" runs on the host, too. The RTL of the instruction is not in this repository,
+* SHA1_ciModel() is the behaviour it has to implement.
+*
+* \note The hash words are state of the CPU, like its registers, but the HAL does not save them on an interrupt:
+*       an interrupt handler must not use the instruction. The C model keeps one state per thread.
+* \todo <todos>
+* \warning The instruction is not part of base_sys.qsys yet. Without it, there is no
+*          ALT_CI_SHA1_CI_N in system.h and SHA1_COMPRESSION_NIOS_CUSTOM_INSTR can not be selected on the Nios II.
+*
+*  Changelog:\n
+*  - <version; data of change; author>
+*            - <description of the change>
+*
+* \copyright Copyright 2023
+* Department of electrical engineering and information technology, Hochschule Darmstadt - University of applied sciences (h_da). All Rights Reserved.
+* Permission to use, copy, modify, and distribute this software and its documentation for educational, and research purposes in the context of non-commercial
+* (unless permitted by h_da) and official h_da projects, is hereby granted for enrolled students of h_da, provided that the above copyright notice,
+* this paragraph and the following paragraph appear in all copies, modifications, and distributions.
+*
+* Contact Prof.Dr. C. Jakob, christian.jakob@h-da.de, Birkenweg 8 64295 Darmstadt - GERMANY for commercial requests.
+*
+* \warning This software is a PROTOTYPE version and is not designed or intended for use in production, especially not for safety-critical applications!
+* The user represents and warrants that it will NOT use or redistribute the Software for such purposes.
+* This prototype is for research purposes only. This software is provided "AS IS," without a warranty of any kind.
+**/
+
+#ifndef MYCODE_SHA1_CI_H_
+#define MYCODE_SHA1_CI_H_
+
+#include "global.h"
+#include "platform.h"
+
+
+/*****************************************************************************/
+/* Global pre-processor symbols/macros and type declarations                 */
+/*****************************************************************************/
+
+//operations, the n field of the instruction
+#define SHA1_CI_OP_LOAD_AB			0	/**< A = dataa, B = datab */
+#define SHA1_CI_OP_LOAD_CD			1	/**< C = dataa, D = datab */
+#define SHA1_CI_OP_LOAD_E			2	/**< E = dataa */
+#define SHA1_CI_OP_ADD				3	/**< result = hash word dataa (SHA1_HASH_A .. SHA1_HASH_E) + datab */
+#define SHA1_CI_OP_ROUND_STAGE_1	4	/**< one round of stage 1 with W[t] = dataa, result = the new A */
+#define SHA1_CI_OP_ROUND_STAGE_2	5	/**< the same with the kernel function and K of stage 2 */
+#define SHA1_CI_OP_ROUND_STAGE_3	6	/**< ... stage 3 */
+#define SHA1_CI_OP_ROUND_STAGE_4	7	/**< ... stage 4 */
+#define SHA1_CI_NUM_OF_OPS			8	/**< width of the n field: 3 bits */
+
+#if defined(__nios2__) && defined(ALT_CI_SHA1_CI_N)
+//the custom instruction "sha1_ci" is connected to the CPU, ALT_CI_SHA1_CI_N in "system.h"
+#define SHA1_CI
+
+#define SHA1_CI_WRITE(op, dataa, datab)		__builtin_custom_nii(ALT_CI_SHA1_CI_N + (op), (int)(dataa), (int)(datab))
+#define SHA1_CI_READ(op, dataa, datab)		((uint32_t)__builtin_custom_inii(ALT_CI_SHA1_CI_N + (op), (int)(dataa), (int)(datab)))
+#else
+#define SHA1_CI_WRITE(op, dataa, datab)		((void)SHA1_ciModel((op), (dataa), (datab)))
+#define SHA1_CI_READ(op, dataa, datab)		SHA1_ciModel((op), (dataa), (datab))
+#endif
+
+/**
+ * \brief Five rounds of one stage on the instruction, W(roundIndex) as in the unrolled Compression Function.
+ */
+#define SHA1_CI_FIVE_ROUNDS(op, roundIndex)													\
+	do {																					\
+		SHA1_CI_WRITE((op), W(roundIndex), 0);												\
+		SHA1_CI_WRITE((op), W((roundIndex) + 1), 0);										\
+		SHA1_CI_WRITE((op), W((roundIndex) + 2), 0);										\
+		SHA1_CI_WRITE((op), W((roundIndex) + 3), 0);										\
+		SHA1_CI_WRITE((op), W((roundIndex) + 4), 0);										\
+	} while(0)
+
+
+/*****************************************************************************/
+/* API functions                                                             */
+/*****************************************************************************/
+
+/**
+ * \brief C model of one custom instruction, bit for bit the behaviour of the hardware.
+ *
+ * Works on the hash words of the calling thread.
+ *
+ * \param uint32_t op : IN - SHA1_CI_OP_*, the n field
+ * \param uint32_t dataa : IN - first operand
+ * \param uint32_t datab : IN - second operand
+ * \return the result of the instruction: the new A of a round, the sum of SHA1_CI_OP_ADD, 0 for the loads
+ */
+uint32_t SHA1_ciModel(uint32_t op, uint32_t dataa, uint32_t datab);
+
+#endif /* MYCODE_SHA1_CI_H_ */
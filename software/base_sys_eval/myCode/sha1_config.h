@@ -33,7 +33,61 @@
 
 /**
  * \brief Macro to enable/disable debug messages.
+ *
+ * The debug messages count the processed blocks in static variables,
+ * so they are not meant to be used while several messages are hashed concurrently.
  */
 #define SHA1_CONFIG_ENABLE_DEBUG	0		/**< '0' means turn debug off, '1' means turn debug on */
 
+/**
+ * \brief Macro to enable/disable the benchmark mode of main().
+ *
+ * After the self-checks, main() hashes messages from 0 bytes up to the largest one that fits into memory
+ * and prints the cycles of every phase, see "bench.h".
+ * Can be overridden from the compiler command line, e.g. -DSHA1_CONFIG_ENABLE_BENCHMARK=1
+ */
+#ifndef SHA1_CONFIG_ENABLE_BENCHMARK
+#define SHA1_CONFIG_ENABLE_BENCHMARK	0		/**< '0' means turn the benchmark off, '1' means turn it on */
+#endif
+
+/**
+ * \brief Possible implementations of the Compression Function behind sha_1().
+ */
+#define SHA1_COMPRESSION_STAGE_DISPATCH	0		/**< 80 loop iterations, each one checks the stage and calls the kernel function */
+#define SHA1_COMPRESSION_UNROLLED		1		/**< 4 stages x 20 rounds fully unrolled, hash words rotated in registers */
+#define SHA1_COMPRESSION_X86_SHA_NI		2		/**< x86 hosts only: SHA extensions if CPUID reports them at start-up, otherwise SHA1_COMPRESSION_UNROLLED */
+#define SHA1_COMPRESSION_AVALON_ACCEL	3		/**< Nios II only: the SHA-1 accelerator of sha1_accel.h, 80 / ROUNDS_PER_CYCLE clock cycles per block */
+#define SHA1_COMPRESSION_NIOS_CUSTOM_INSTR	4	/**< the round step custom instruction of "sha1_ci.h", its C model on the host */
+
+/**
+ * \brief Macro to select the implementation of the Compression Function used by sha_1().
+ *
+ * All implementations give bit-for-bit the same result, main() checks this at start-up.
+ * The debug messages of SHA1_CONFIG_ENABLE_DEBUG are only printed by SHA1_COMPRESSION_STAGE_DISPATCH.
+ * SHA1_COMPRESSION_X86_SHA_NI needs "sha1_ni.c" in the build.
+ * SHA1_COMPRESSION_AVALON_ACCEL needs "sha1_accel.c" in the build and the accelerator in base_sys.qsys (SHA1_ACCEL_BASE).
+ * SHA1_COMPRESSION_NIOS_CUSTOM_INSTR needs "sha1_ci.c" in the build, and on the Nios II the instruction in base_sys.qsys
+ * (ALT_CI_SHA1_CI_N).
+ * Can be overridden from the compiler command line, e.g. -DSHA1_CONFIG_COMPRESSION=SHA1_COMPRESSION_X86_SHA_NI
+ */
+#ifndef SHA1_CONFIG_COMPRESSION
+#define SHA1_CONFIG_COMPRESSION		SHA1_COMPRESSION_UNROLLED
+#endif
+
+/**
+ * \brief Possible message schedules (word expansion) of the unrolled Compression Function.
+ */
+#define SHA1_SCHEDULE_EXPANDED_80		0		/**< all 80 words are expanded into an 80-word buffer before the first round */
+#define SHA1_SCHEDULE_ROLLING_16		1		/**< W[t] is computed inside the rounds, in a 16-word circular buffer */
+
+/**
+ * \brief Macro to select the message schedule used by SHA1_COMPRESSION_UNROLLED.
+ *
+ * SHA1_COMPRESSION_STAGE_DISPATCH always uses SHA1_SCHEDULE_EXPANDED_80.
+ * Can be overridden from the compiler command line, like SHA1_CONFIG_COMPRESSION.
+ */
+#ifndef SHA1_CONFIG_SCHEDULE
+#define SHA1_CONFIG_SCHEDULE		SHA1_SCHEDULE_ROLLING_16
+#endif
+
 #endif /* SHA1_CONFIG_H_ */
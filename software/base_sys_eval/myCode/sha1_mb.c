@@ -0,0 +1,378 @@
+/**
+* \file   sha1_mb.c
+* \author Trung Tin Nguyen (1120436), and Dung Anh Huynh Pham (764527)
+* \date   17.10.2026
+*
+* \brief multi-buffer SHA-1 engine, hashes several independent messages per call
+*
+* \copyright Copyright 2023
+* Department of electrical engineering and information technology, Hochschule Darmstadt - University of applied sciences (h_da). All Rights Reserved.
+* Permission to use, copy, modify, and distribute this software and its documentation for educational, and research purposes in the context of non-commercial
+* (unless permitted by h_da) and official h_da projects, is hereby granted for enrolled students of h_da, provided that the above copyright notice,
+* this paragraph and the following paragraph appear in all copies, modifications, and distributions.
+*
+* Contact Prof.Dr. C. Jakob, christian.jakob@h-da.de, Birkenweg 8 64295 Darmstadt - GERMANY for commercial requests.
+*
+* \warning This software is a PROTOTYPE version and is not designed or intended for use in production, especially not for safety-critical applications!
+* The user represents and warrants that it will NOT use or redistribute the Software for such purposes.
+* This prototype is for research purposes only. This software is provided "AS IS," without a warranty of any kind.
+*/
+
+/*****************************************************************************/
+/* Include files                                                             */
+/*****************************************************************************/
+#include <string.h> //for the usage of memcpy()
+
+#include "sha1.h"
+#include "sha1_mb.h"
+#include "sha1_rounds.h"
+
+
+/*****************************************************************************/
+/* Local pre-processor symbols/macros ('#define')                            */
+/*****************************************************************************/
+
+/**
+ * \brief The SIMD kernels use GCC vector extensions and x86 target attributes.
+ */
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define SHA1_MB_ENABLE_X86_SIMD		1
+#else
+#define SHA1_MB_ENABLE_X86_SIMD		0
+#endif
+
+/**
+ * \brief The padded tail of a message takes 1 or 2 blocks.
+ */
+#define SHA1_MB_MAX_TAIL_BLOCKS		2		/**< in blocks */
+
+
+/*****************************************************************************/
+/* Local type definitions                                                    */
+/*****************************************************************************/
+
+/**
+ * \brief State of one lane of the multi-buffer engine.
+ */
+struct sSHA1_mbLane {
+  SHA1_mbJob_t*		m_job;											/**< job of this lane, NULL if the lane is idle */
+  const uint8_t*	m_nextFullBlock;								/**< next whole 512-bit block, read from the message */
+  uint64_t			m_numOfFullBlocksLeft;							/**< whole 512-bit blocks not compressed yet */
+  uint8_t			m_tail[SHA1_MB_MAX_TAIL_BLOCKS * SHA1_BLOCK_SIZE_IN_BYTES];	/**< the last bytes + Padding + length */
+  uint32_t			m_numOfTailBlocks;								/**< 1 or 2 */
+  uint32_t			m_tailBlockIndex;								/**< next tail block to compress */
+};
+typedef struct sSHA1_mbLane SHA1_mbLane_t;
+
+/**
+ * \brief Multi-buffer Compression Function, one 512-bit block per lane.
+ */
+typedef void (*SHA1_mbCompress_t)(uint32_t * state, const uint8_t * const * block);
+
+
+/*****************************************************************************/
+/* Local variable definitions ('static')                                     */
+/*****************************************************************************/
+
+/**
+ * \brief Block that is fed into idle lanes, its result is thrown away.
+ */
+static const uint8_t SHA1_mbIdleBlock[SHA1_BLOCK_SIZE_IN_BYTES] = {0};
+
+
+/*****************************************************************************/
+/* Local function prototypes ('static')                                      */
+/*****************************************************************************/
+
+/**
+ * \brief This function assigns a job to an idle lane: the chaining hash words of the lane are set to
+ * 		  the magic numbers (FIPS PUB 180-1), and the padded tail of the message is built.
+ *
+ * \param SHA1_mbLane_t* lane : OUT - the idle lane
+ * \param SHA1_mbJob_t* job : IN - the job
+ * \param uint32_t * state : OUT - chaining hash words of all lanes
+ * \param uint32_t laneIndex : IN - index of the lane
+ * \param uint32_t numOfLanes : IN - number of lanes of the kernel
+ */
+static void SHA1_mbStartJob(SHA1_mbLane_t* lane, SHA1_mbJob_t* job, uint32_t * state, uint32_t laneIndex, uint32_t numOfLanes);
+
+/**
+ * \brief This function runs the jobs through the lanes of a multi-buffer kernel and refills
+ * 		  every lane as soon as its message is finished.
+ *
+ * \param SHA1_mbJob_t* jobs : IN/OUT - array of jobs
+ * \param uint64_t numOfJobs : IN - number of jobs in the array
+ * \param uint32_t numOfLanes : IN - number of lanes of the kernel
+ * \param SHA1_mbCompress_t compress : IN - the kernel
+ */
+static void SHA1_mbRunLanes(SHA1_mbJob_t* jobs, uint64_t numOfJobs, uint32_t numOfLanes, SHA1_mbCompress_t compress);
+
+/**
+ * \brief This function loads one Big Endian word from any address.
+ *
+ * \param const uint8_t * bytes : IN - 4 bytes of the message
+ * \return the word
+ */
+static inline uint32_t SHA1_mbLoadBigEndianWord(const uint8_t * bytes);
+
+
+/*****************************************************************************/
+/* Multi-buffer kernels                                                      */
+/*****************************************************************************/
+
+#if SHA1_MB_ENABLE_X86_SIMD
+
+typedef uint32_t SHA1_mbVector4_t  __attribute__((vector_size(16)));	/**< 4 lanes, one SSE2 register */
+typedef uint32_t SHA1_mbVector8_t  __attribute__((vector_size(32)));	/**< 8 lanes, one AVX2 register */
+typedef uint32_t SHA1_mbVector16_t __attribute__((vector_size(64)));	/**< 16 lanes, one AVX-512 register */
+
+#define SHA1_MB_KERNEL_NAME				SHA1_mbCompressSSE2
+#define SHA1_MB_KERNEL_VECTOR_T			SHA1_mbVector4_t
+#define SHA1_MB_KERNEL_NUM_OF_LANES		4
+#define SHA1_MB_KERNEL_TARGET			"sse2"
+#include "sha1_mb_kernel.h"
+
+#define SHA1_MB_KERNEL_NAME				SHA1_mbCompressAVX2
+#define SHA1_MB_KERNEL_VECTOR_T			SHA1_mbVector8_t
+#define SHA1_MB_KERNEL_NUM_OF_LANES		8
+#define SHA1_MB_KERNEL_TARGET			"avx2"
+#include "sha1_mb_kernel.h"
+
+#define SHA1_MB_KERNEL_NAME				SHA1_mbCompressAVX512
+#define SHA1_MB_KERNEL_VECTOR_T			SHA1_mbVector16_t
+#define SHA1_MB_KERNEL_NUM_OF_LANES		16
+#define SHA1_MB_KERNEL_TARGET			"avx512f"
+#include "sha1_mb_kernel.h"
+
+#endif /* SHA1_MB_ENABLE_X86_SIMD */
+
+
+/*****************************************************************************/
+/* Function implementation - global ('extern') and local ('static')          */
+/*****************************************************************************/
+
+/**
+ * \brief Number of lanes of the widest multi-buffer kernel that this CPU supports.
+ *
+ * \return 16 (AVX-512), 8 (AVX2), 4 (SSE2) or 1 (no SIMD kernel, messages are hashed one by one)
+ */
+uint32_t SHA1_mbGetNumOfLanes(void)
+{
+#if SHA1_MB_ENABLE_X86_SIMD
+
+	__builtin_cpu_init();
+
+	if(__builtin_cpu_supports("avx512f"))
+	{
+		return 16;
+	}
+	if(__builtin_cpu_supports("avx2"))
+	{
+		return 8;
+	}
+	if(__builtin_cpu_supports("sse2"))
+	{
+		return 4;
+	}
+
+#endif
+
+	return 1;
+}
+
+/**
+ * \brief Hash a list of independent messages with the multi-buffer engine.
+ *
+ * Every lane works on its own message. When a message is finished, its lane is refilled
+ * with the next job right away, so messages of different lengths keep all lanes busy.
+ * The whole 512-bit blocks are read straight from the messages, only the padded tail is copied.
+ *
+ * \param SHA1_mbJob_t* jobs : IN/OUT - array of jobs, m_hash is written for every job
+ * \param uint64_t numOfJobs : IN - number of jobs in the array
+ * \param uint32_t numOfLanes : IN - 16, 8, 4 or 1 to force a kernel, 0 (or a kernel the CPU does not support)
+ *                                   selects SHA1_mbGetNumOfLanes()
+ */
+void SHA1_mbHashJobs(SHA1_mbJob_t* jobs, uint64_t numOfJobs, uint32_t numOfLanes)
+{
+	uint32_t numOfSupportedLanes = SHA1_mbGetNumOfLanes();
+
+	//a wider kernel than the CPU supports (or 0) => take the widest supported one
+	if((numOfLanes == 0) || (numOfLanes > numOfSupportedLanes))
+	{
+		numOfLanes = numOfSupportedLanes;
+	}
+
+#if SHA1_MB_ENABLE_X86_SIMD
+
+	if(numOfLanes == 16)
+	{
+		SHA1_mbRunLanes(jobs, numOfJobs, 16, SHA1_mbCompressAVX512);
+		return;
+	}
+	if(numOfLanes == 8)
+	{
+		SHA1_mbRunLanes(jobs, numOfJobs, 8, SHA1_mbCompressAVX2);
+		return;
+	}
+	if(numOfLanes == 4)
+	{
+		SHA1_mbRunLanes(jobs, numOfJobs, 4, SHA1_mbCompressSSE2);
+		return;
+	}
+
+#endif
+
+	//scalar fallback: one message after the other, with the Compression Function selected in "sha1_config.h"
+	for(uint64_t jobIndex = 0; jobIndex < numOfJobs; jobIndex++)
+	{
+		SHA1_hashBuffer(jobs[jobIndex].m_hash, jobs[jobIndex].m_data, jobs[jobIndex].m_length);
+	}
+}
+
+/**
+ * \brief This function runs the jobs through the lanes of a multi-buffer kernel and refills
+ * 		  every lane as soon as its message is finished.
+ *
+ * \param SHA1_mbJob_t* jobs : IN/OUT - array of jobs
+ * \param uint64_t numOfJobs : IN - number of jobs in the array
+ * \param uint32_t numOfLanes : IN - number of lanes of the kernel
+ * \param SHA1_mbCompress_t compress : IN - the kernel
+ */
+static void SHA1_mbRunLanes(SHA1_mbJob_t* jobs, uint64_t numOfJobs, uint32_t numOfLanes, SHA1_mbCompress_t compress)
+{
+	SHA1_mbLane_t lane[SHA1_MB_MAX_LANES];
+	uint32_t state[SHA1_NUM_OF_HASH_WORDS_PER_BLOCK * SHA1_MB_MAX_LANES];
+	const uint8_t* block[SHA1_MB_MAX_LANES];
+	uint64_t nextJobIndex = 0;
+
+	for(uint32_t laneIndex = 0; laneIndex < numOfLanes; laneIndex++)
+	{
+		lane[laneIndex].m_job = NULL;
+	}
+
+	while(1)
+	{
+		uint32_t numOfActiveLanes = 0;
+
+		//refill the idle lanes and collect the next block of every lane
+		for(uint32_t laneIndex = 0; laneIndex < numOfLanes; laneIndex++)
+		{
+			if((lane[laneIndex].m_job == NULL) && (nextJobIndex < numOfJobs))
+			{
+				SHA1_mbStartJob(&lane[laneIndex], &jobs[nextJobIndex], state, laneIndex, numOfLanes);
+				nextJobIndex++;
+			}
+
+			if(lane[laneIndex].m_job == NULL)
+			{
+				block[laneIndex] = SHA1_mbIdleBlock;
+			}
+			else if(lane[laneIndex].m_numOfFullBlocksLeft > 0)
+			{
+				block[laneIndex] = lane[laneIndex].m_nextFullBlock;
+				numOfActiveLanes++;
+			}
+			else
+			{
+				block[laneIndex] = &lane[laneIndex].m_tail[lane[laneIndex].m_tailBlockIndex * SHA1_BLOCK_SIZE_IN_BYTES];
+				numOfActiveLanes++;
+			}
+		}
+
+		//all jobs are finished
+		if(numOfActiveLanes == 0)
+		{
+			return;
+		}
+
+		compress(state, block);
+
+		//move every lane to its next block, hand out the hash of the finished messages
+		for(uint32_t laneIndex = 0; laneIndex < numOfLanes; laneIndex++)
+		{
+			SHA1_mbLane_t* currentLane = &lane[laneIndex];
+
+			if(currentLane->m_job == NULL)
+			{
+				continue;
+			}
+
+			if(currentLane->m_numOfFullBlocksLeft > 0)
+			{
+				currentLane->m_nextFullBlock += SHA1_BLOCK_SIZE_IN_BYTES;
+				currentLane->m_numOfFullBlocksLeft--;
+				continue;
+			}
+
+			currentLane->m_tailBlockIndex++;
+
+			if(currentLane->m_tailBlockIndex == currentLane->m_numOfTailBlocks)
+			{
+				for(uint8_t hashIndex = SHA1_HASH_A; hashIndex < SHA1_NUM_OF_HASH_WORDS_PER_BLOCK; hashIndex++)
+				{
+					currentLane->m_job->m_hash[hashIndex] = state[(hashIndex * numOfLanes) + laneIndex];
+				}
+
+				currentLane->m_job = NULL;
+			}
+		}
+	}
+}
+
+/**
+ * \brief This function assigns a job to an idle lane: the chaining hash words of the lane are set to
+ * 		  the magic numbers (FIPS PUB 180-1), and the padded tail of the message is built.
+ *
+ * \param SHA1_mbLane_t* lane : OUT - the idle lane
+ * \param SHA1_mbJob_t* job : IN - the job
+ * \param uint32_t * state : OUT - chaining hash words of all lanes
+ * \param uint32_t laneIndex : IN - index of the lane
+ * \param uint32_t numOfLanes : IN - number of lanes of the kernel
+ */
+static void SHA1_mbStartJob(SHA1_mbLane_t* lane, SHA1_mbJob_t* job, uint32_t * state, uint32_t laneIndex, uint32_t numOfLanes)
+{
+	const uint8_t* data = (const uint8_t*)job->m_data;
+	uint64_t numOfFullBlocks = job->m_length / SHA1_BLOCK_SIZE_IN_BYTES;
+	uint32_t numOfTailBytes = (uint32_t)(job->m_length % SHA1_BLOCK_SIZE_IN_BYTES);
+	uint64_t messageLengthInBits = job->m_length * 8;
+
+	state[(SHA1_HASH_A * numOfLanes) + laneIndex] = SHA1_INIT_HASH_A;
+	state[(SHA1_HASH_B * numOfLanes) + laneIndex] = SHA1_INIT_HASH_B;
+	state[(SHA1_HASH_C * numOfLanes) + laneIndex] = SHA1_INIT_HASH_C;
+	state[(SHA1_HASH_D * numOfLanes) + laneIndex] = SHA1_INIT_HASH_D;
+	state[(SHA1_HASH_E * numOfLanes) + laneIndex] = SHA1_INIT_HASH_E;
+
+	lane->m_job = job;
+	lane->m_nextFullBlock = data;
+	lane->m_numOfFullBlocksLeft = numOfFullBlocks;
+	lane->m_tailBlockIndex = 0;
+
+	//no space left for the 0x80 byte and the 64-bit length => the tail needs 2 blocks
+	lane->m_numOfTailBlocks = (numOfTailBytes < SHA1_LENGTH_FIELD_OFFSET_IN_BYTES) ? 1 : 2;
+
+	uint32_t tailLength = lane->m_numOfTailBlocks * SHA1_BLOCK_SIZE_IN_BYTES;
+
+	//the last bytes of the message, the Padding and the 64-bit representation of the length (Big Endian)
+	memcpy(lane->m_tail, data + (numOfFullBlocks * SHA1_BLOCK_SIZE_IN_BYTES), numOfTailBytes);
+	lane->m_tail[numOfTailBytes] = 0x80;
+	memset(&lane->m_tail[numOfTailBytes + 1], 0, tailLength - 8 - (numOfTailBytes + 1));
+
+	for(uint8_t byteIndex = 0; byteIndex < 8; byteIndex++)
+	{
+		lane->m_tail[tailLength - 8 + byteIndex] = (uint8_t)(messageLengthInBits >> (56 - (8 * byteIndex)));
+	}
+}
+
+/**
+ * \brief This function loads one Big Endian word from any address.
+ *
+ * \param const uint8_t * bytes : IN - 4 bytes of the message
+ * \return the word
+ */
+static inline uint32_t SHA1_mbLoadBigEndianWord(const uint8_t * bytes)
+{
+	return ((uint32_t)bytes[0] << 24) |
+		   ((uint32_t)bytes[1] << 16) |
+		   ((uint32_t)bytes[2] << 8)  |
+		   ((uint32_t)bytes[3]);
+}
@@ -0,0 +1,89 @@
+/**
+* \file   sha1_mb.h
+* \author Trung Tin Nguyen (1120436), and Dung Anh Huynh Pham (764527)
+* \date   17.10.2026
+*
+* \brief multi-buffer SHA-1 engine, hashes several independent messages per call
+*
+* This file contains API of the multi-buffer SHA-1 engine. On x86 hosts, the 80 rounds run on 4 (SSE2),
+* 8 (AVX2) or 16 (AVX-512) messages at once, one message per SIMD lane. The widest kernel is chosen at
+* run time from the CPU features. On other CPUs (e.g. the Nios II) the messages are hashed one by one.
+*
+* \note <notes>
+* \todo <todos>
+* \warning <warnings, e.g. dependencies, order of execution etc.>
+*
+*  Changelog:\n
+*  - <version; data of change; author>
+*            - <description of the change>
+*
+* \copyright Copyright 2023
+* Department of electrical engineering and information technology, Hochschule Darmstadt - University of applied sciences (h_da). All Rights Reserved.
+* Permission to use, copy, modify, and distribute this software and its documentation for educational, and research purposes in the context of non-commercial
+* (unless permitted by h_da) and official h_da projects, is hereby granted for enrolled students of h_da, provided that the above copyright notice,
+* this paragraph and the following paragraph appear in all copies, modifications, and distributions.
+*
+* Contact Prof.Dr. C. Jakob, christian.jakob@h-da.de, Birkenweg 8 64295 Darmstadt - GERMANY for commercial requests.
+*
+* \warning This software is a PROTOTYPE version and is not designed or intended for use in production, especially not for safety-critical applications!
+* The user represents and warrants that it will NOT use or redistribute the Software for such purposes.
+* This prototype is for research purposes only. This software is provided "AS IS," without a warranty of any kind.
+**/
+
+#ifndef SHA1_MB_H_
+#define SHA1_MB_H_
+
+#include "global.h"
+#include "sha1.h"
+
+/*****************************************************************************/
+/* Global pre-processor symbols/macros and type declarations                 */
+/*****************************************************************************/
+
+//####################### Defines/Macros
+
+/**
+ * \brief Max number of messages that are hashed at once (AVX-512: 16 x 32-bit lanes).
+ */
+#define SHA1_MB_MAX_LANES	16		/**< in lanes */
+
+
+//####################### Structures
+
+/**
+ * \brief One multi-buffer job: a message and its final hash.
+ */
+struct sSHA1_mbJob {
+  const void*	m_data;										/**< IN - the message, any alignment, may contain '\0' */
+  uint64_t		m_length;									/**< IN - length of the message, in bytes */
+  uint32_t		m_hash[SHA1_NUM_OF_HASH_WORDS_PER_BLOCK];	/**< OUT - the 5 final hash words */
+};
+typedef struct sSHA1_mbJob SHA1_mbJob_t;
+
+
+/*****************************************************************************/
+/* API functions                                                             */
+/*****************************************************************************/
+
+/**
+ * \brief Number of lanes of the widest multi-buffer kernel that this CPU supports.
+ *
+ * \return 16 (AVX-512), 8 (AVX2), 4 (SSE2) or 1 (no SIMD kernel, messages are hashed one by one)
+ */
+uint32_t SHA1_mbGetNumOfLanes(void);
+
+/**
+ * \brief Hash a list of independent messages with the multi-buffer engine.
+ *
+ * Every lane works on its own message. When a message is finished, its lane is refilled
+ * with the next job right away, so messages of different lengths keep all lanes busy.
+ * The whole 512-bit blocks are read straight from the messages, only the padded tail is copied.
+ *
+ * \param SHA1_mbJob_t* jobs : IN/OUT - array of jobs, m_hash is written for every job
+ * \param uint64_t numOfJobs : IN - number of jobs in the array
+ * \param uint32_t numOfLanes : IN - 16, 8, 4 or 1 to force a kernel, 0 (or a kernel the CPU does not support)
+ *                                   selects SHA1_mbGetNumOfLanes()
+ */
+void SHA1_mbHashJobs(SHA1_mbJob_t* jobs, uint64_t numOfJobs, uint32_t numOfLanes);
+
+#endif /* SHA1_MB_H_ */
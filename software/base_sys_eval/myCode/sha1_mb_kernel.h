@@ -0,0 +1,122 @@
+/**
+* \file   sha1_mb_kernel.h
+* \author Trung Tin Nguyen (1120436), and Dung Anh Huynh Pham (764527)
+* \date   17.10.2026
+*
+* \brief template of the multi-buffer SHA-1 Compression Function
+*
+* This file is included by "sha1_mb.c" once per SIMD width. Before each inclusion, the following macros
+* must be defined, they are undefined again at the end of this file:
+* - SHA1_MB_KERNEL_NAME:          name of the generated function
+* - SHA1_MB_KERNEL_VECTOR_T:      GCC vector type with one uint32_t lane per message
+* - SHA1_MB_KERNEL_NUM_OF_LANES:  number of lanes of SHA1_MB_KERNEL_VECTOR_T
+* - SHA1_MB_KERNEL_TARGET:        GCC target string of the instruction set, e.g. "avx2"
+*
+* The kernel is the unrolled Compression Function with the rolling 16-word schedule (see "sha1_rounds.h"),
+* with every uint32_t replaced by a vector.
+*
+* \note <notes>
+* \todo <todos>
+* \warning <warnings, e.g. dependencies, order of execution etc.>
+*
+*  Changelog:\n
+*  - <version; data of change; author>
+*            - <description of the change>
+*
+* \copyright Copyright 2023
+* Department of electrical engineering and information technology, Hochschule Darmstadt - University of applied sciences (h_da). All Rights Reserved.
+* Permission to use, copy, modify, and distribute this software and its documentation for educational, and research purposes in the context of non-commercial
+* (unless permitted by h_da) and official h_da projects, is hereby granted for enrolled students of h_da, provided that the above copyright notice,
+* this paragraph and the following paragraph appear in all copies, modifications, and distributions.
+*
+* Contact Prof.Dr. C. Jakob, christian.jakob@h-da.de, Birkenweg 8 64295 Darmstadt - GERMANY for commercial requests.
+*
+* \warning This software is a PROTOTYPE version and is not designed or intended for use in production, especially not for safety-critical applications!
+* The user represents and warrants that it will NOT use or redistribute the Software for such purposes.
+* This prototype is for research purposes only. This software is provided "AS IS," without a warranty of any kind.
+**/
+
+/*
+ * no include guard: this file is meant to be included several times.
+ */
+
+/**
+ * \brief Multi-buffer Compression Function, one 512-bit block per lane.
+ *
+ * \param uint32_t * state : IN/OUT - chaining hash words, hash word h of lane l is at state[h * NUM_OF_LANES + l]
+ * \param const uint8_t * const * block : IN - one pointer to 64 bytes of message per lane, any alignment
+ */
+__attribute__((target(SHA1_MB_KERNEL_TARGET)))
+static void SHA1_MB_KERNEL_NAME(uint32_t * state, const uint8_t * const * block)
+{
+	//16-word circular message schedule, one message per lane
+	SHA1_MB_KERNEL_VECTOR_T w[SHA1_TOTAL_WORDS_PER_BLOCK];
+
+	//transpose: word t of lane l goes into lane l of vector w[t]
+	for(uint8_t wordIndex = 0; wordIndex < SHA1_TOTAL_WORDS_PER_BLOCK; wordIndex++)
+	{
+		for(uint8_t laneIndex = 0; laneIndex < SHA1_MB_KERNEL_NUM_OF_LANES; laneIndex++)
+		{
+			w[wordIndex][laneIndex] = SHA1_mbLoadBigEndianWord(block[laneIndex] + (4 * wordIndex));
+		}
+	}
+
+	SHA1_MB_KERNEL_VECTOR_T a, b, c, d, e;
+
+	memcpy(&a, &state[SHA1_HASH_A * SHA1_MB_KERNEL_NUM_OF_LANES], sizeof(a));
+	memcpy(&b, &state[SHA1_HASH_B * SHA1_MB_KERNEL_NUM_OF_LANES], sizeof(b));
+	memcpy(&c, &state[SHA1_HASH_C * SHA1_MB_KERNEL_NUM_OF_LANES], sizeof(c));
+	memcpy(&d, &state[SHA1_HASH_D * SHA1_MB_KERNEL_NUM_OF_LANES], sizeof(d));
+	memcpy(&e, &state[SHA1_HASH_E * SHA1_MB_KERNEL_NUM_OF_LANES], sizeof(e));
+
+	const SHA1_MB_KERNEL_VECTOR_T prevA = a;
+	const SHA1_MB_KERNEL_VECTOR_T prevB = b;
+	const SHA1_MB_KERNEL_VECTOR_T prevC = c;
+	const SHA1_MB_KERNEL_VECTOR_T prevD = d;
+	const SHA1_MB_KERNEL_VECTOR_T prevE = e;
+
+#define W(roundIndex)	SHA1_ROLLING_WORD(w, roundIndex)
+
+	//stage 1: rounds 0 .. 19
+	SHA1_UNROLLED_FIVE_ROUNDS(SHA1_KERNEL_CH, SHA1_K_STAGE_1, 0);
+	SHA1_UNROLLED_FIVE_ROUNDS(SHA1_KERNEL_CH, SHA1_K_STAGE_1, 5);
+	SHA1_UNROLLED_FIVE_ROUNDS(SHA1_KERNEL_CH, SHA1_K_STAGE_1, 10);
+	SHA1_UNROLLED_FIVE_ROUNDS(SHA1_KERNEL_CH, SHA1_K_STAGE_1, 15);
+
+	//stage 2: rounds 20 .. 39
+	SHA1_UNROLLED_FIVE_ROUNDS(SHA1_KERNEL_PARITY, SHA1_K_STAGE_2, 20);
+	SHA1_UNROLLED_FIVE_ROUNDS(SHA1_KERNEL_PARITY, SHA1_K_STAGE_2, 25);
+	SHA1_UNROLLED_FIVE_ROUNDS(SHA1_KERNEL_PARITY, SHA1_K_STAGE_2, 30);
+	SHA1_UNROLLED_FIVE_ROUNDS(SHA1_KERNEL_PARITY, SHA1_K_STAGE_2, 35);
+
+	//stage 3: rounds 40 .. 59
+	SHA1_UNROLLED_FIVE_ROUNDS(SHA1_KERNEL_MAJ, SHA1_K_STAGE_3, 40);
+	SHA1_UNROLLED_FIVE_ROUNDS(SHA1_KERNEL_MAJ, SHA1_K_STAGE_3, 45);
+	SHA1_UNROLLED_FIVE_ROUNDS(SHA1_KERNEL_MAJ, SHA1_K_STAGE_3, 50);
+	SHA1_UNROLLED_FIVE_ROUNDS(SHA1_KERNEL_MAJ, SHA1_K_STAGE_3, 55);
+
+	//stage 4: rounds 60 .. 79
+	SHA1_UNROLLED_FIVE_ROUNDS(SHA1_KERNEL_PARITY, SHA1_K_STAGE_4, 60);
+	SHA1_UNROLLED_FIVE_ROUNDS(SHA1_KERNEL_PARITY, SHA1_K_STAGE_4, 65);
+	SHA1_UNROLLED_FIVE_ROUNDS(SHA1_KERNEL_PARITY, SHA1_K_STAGE_4, 70);
+	SHA1_UNROLLED_FIVE_ROUNDS(SHA1_KERNEL_PARITY, SHA1_K_STAGE_4, 75);
+
+#undef W
+
+	a += prevA;
+	b += prevB;
+	c += prevC;
+	d += prevD;
+	e += prevE;
+
+	memcpy(&state[SHA1_HASH_A * SHA1_MB_KERNEL_NUM_OF_LANES], &a, sizeof(a));
+	memcpy(&state[SHA1_HASH_B * SHA1_MB_KERNEL_NUM_OF_LANES], &b, sizeof(b));
+	memcpy(&state[SHA1_HASH_C * SHA1_MB_KERNEL_NUM_OF_LANES], &c, sizeof(c));
+	memcpy(&state[SHA1_HASH_D * SHA1_MB_KERNEL_NUM_OF_LANES], &d, sizeof(d));
+	memcpy(&state[SHA1_HASH_E * SHA1_MB_KERNEL_NUM_OF_LANES], &e, sizeof(e));
+}
+
+#undef SHA1_MB_KERNEL_NAME
+#undef SHA1_MB_KERNEL_VECTOR_T
+#undef SHA1_MB_KERNEL_NUM_OF_LANES
+#undef SHA1_MB_KERNEL_TARGET
@@ -0,0 +1,273 @@
+/**
+* \file   sha1_ni.c
+* \author Trung Tin Nguyen (1120436), and Dung Anh Huynh Pham (764527)
+* \date   17.10.2026
+*
+* \brief SHA-1 Compression Function built on the x86 SHA extensions (SHA-NI)
+*
+* \copyright Copyright 2023
+* Department of electrical engineering and information technology, Hochschule Darmstadt - University of applied sciences (h_da). All Rights Reserved.
+* Permission to use, copy, modify, and distribute this software and its documentation for educational, and research purposes in the context of non-commercial
+* (unless permitted by h_da) and official h_da projects, is hereby granted for enrolled students of h_da, provided that the above copyright notice,
+* this paragraph and the following paragraph appear in all copies, modifications, and distributions.
+*
+* Contact Prof.Dr. C. Jakob, christian.jakob@h-da.de, Birkenweg 8 64295 Darmstadt - GERMANY for commercial requests.
+*
+* \warning This software is a PROTOTYPE version and is not designed or intended for use in production, especially not for safety-critical applications!
+* The user represents and warrants that it will NOT use or redistribute the Software for such purposes.
+* This prototype is for research purposes only. This software is provided "AS IS," without a warranty of any kind.
+*/
+
+
+/*****************************************************************************/
+/* Include files                                                             */
+/*****************************************************************************/
+#include "sha1.h"
+#include "sha1_ni.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <cpuid.h>		//for __get_cpuid() and __get_cpuid_count()
+#include <immintrin.h>	//for the SHA-NI intrinsics
+#endif
+
+
+/*****************************************************************************/
+/* Local pre-processor symbols/macros ('#define')                            */
+/*****************************************************************************/
+
+/**
+ * \brief The SHA-NI code uses GCC target attributes, so no extra compiler flags are needed.
+ */
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define SHA1_NI_ENABLE		1
+#else
+#define SHA1_NI_ENABLE		0
+#endif
+
+/**
+ * \brief CPUID feature bits.
+ */
+#define SHA1_NI_CPUID_1_ECX_SSSE3		(1u << 9)		/**< CPUID leaf 1, ECX */
+#define SHA1_NI_CPUID_1_ECX_SSE41		(1u << 19)		/**< CPUID leaf 1, ECX */
+#define SHA1_NI_CPUID_7_EBX_SHA			(1u << 29)		/**< CPUID leaf 7 sub-leaf 0, EBX */
+
+/**
+ * \brief Four rounds from round 16 on, with the message schedule of the next rounds interleaved.
+ *
+ * sha1rnds4 does 4 rounds, sha1nexte derives E of the next 4 rounds from A of the previous ones and adds
+ * the 4 schedule words. sha1msg1 / xor / sha1msg2 compute the schedule 16 words ahead.
+ * The 4 message registers and E0/E1 are rotated by renaming, like the hash words in "sha1_rounds.h".
+ */
+#define SHA1_NI_FOUR_ROUNDS(eCurrent, eNext, msgCurrent, msgNext1, msgNext2, msgNext3, stage)	\
+	do {																					\
+		eCurrent   = _mm_sha1nexte_epu32(eCurrent, msgCurrent);								\
+		eNext      = abcd;																	\
+		msgNext1   = _mm_sha1msg2_epu32(msgNext1, msgCurrent);								\
+		abcd       = _mm_sha1rnds4_epu32(abcd, eCurrent, (stage));							\
+		msgNext3   = _mm_sha1msg1_epu32(msgNext3, msgCurrent);								\
+		msgNext2   = _mm_xor_si128(msgNext2, msgCurrent);									\
+	} while(0)
+
+
+/*****************************************************************************/
+/* Local variable definitions ('static')                                     */
+/*****************************************************************************/
+
+/**
+ * \brief Compression Function of SHA1_niCompressDispatch(), selected once at start-up.
+ *
+ * Only written by SHA1_niSelectAtStartUp() before main() runs, so later readers need no locking.
+ */
+static void (*SHA1_niSelectedCompress)(uint32_t * hash_ptr, const uint32_t * message, const uint32_t * prev_hash) = SHA1_compressUnrolled;
+
+
+/*****************************************************************************/
+/* Function implementation - global ('extern') and local ('static')          */
+/*****************************************************************************/
+
+/**
+ * \brief Checks through CPUID if the CPU supports the SHA extensions (and SSSE3/SSE4.1 used next to them).
+ *
+ * \return TRUE if SHA1_niCompress() can be called on this CPU, otherwise FALSE
+ */
+boolean_t SHA1_niIsSupported(void)
+{
+#if SHA1_NI_ENABLE
+
+	unsigned int eax = 0, ebx = 0, ecx = 0, edx = 0;
+
+	if(0 == __get_cpuid(1, &eax, &ebx, &ecx, &edx))
+	{
+		return FALSE;
+	}
+
+	if(((ecx & SHA1_NI_CPUID_1_ECX_SSSE3) == 0) || ((ecx & SHA1_NI_CPUID_1_ECX_SSE41) == 0))
+	{
+		return FALSE;
+	}
+
+	if(0 == __get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx))
+	{
+		return FALSE;
+	}
+
+	return ((ebx & SHA1_NI_CPUID_7_EBX_SHA) != 0) ? TRUE : FALSE;
+
+#else
+
+	return FALSE;
+
+#endif
+}
+
+/**
+ * \brief Selects the Compression Function of SHA1_niCompressDispatch() before main() runs.
+ */
+#if defined(__GNUC__)
+__attribute__((constructor))
+#endif
+static void SHA1_niSelectAtStartUp(void)
+{
+	if(TRUE == SHA1_niIsSupported())
+	{
+		SHA1_niSelectedCompress = SHA1_niCompress;
+	}
+}
+
+/**
+ * \brief Compression Function chosen at start-up: SHA1_niCompress() if the CPU supports it,
+ * 		  otherwise SHA1_compressUnrolled().
+ *
+ * This is what sha_1() calls when SHA1_CONFIG_COMPRESSION is SHA1_COMPRESSION_X86_SHA_NI.
+ *
+ * \param uint32_t * hash_ptr : OUT - pointer to the processed hash
+ * \param const uint32_t * message : IN - the pre-processed 512-bit wide input message
+ * \param const uint32_t * prev_hash : IN - pointer to the initial hash
+ */
+void SHA1_niCompressDispatch(uint32_t * hash_ptr, const uint32_t * message, const uint32_t * prev_hash)
+{
+	SHA1_niSelectedCompress(hash_ptr, message, prev_hash);
+}
+
+#if SHA1_NI_ENABLE
+
+/**
+ * \brief Compression Function built on the x86 SHA extensions.
+ *
+ * Must only be called if SHA1_niIsSupported() returns TRUE.
+ * hash_ptr may point to the same array as prev_hash.
+ *
+ * \param uint32_t * hash_ptr : OUT - pointer to the processed hash
+ * \param const uint32_t * message : IN - the pre-processed 512-bit wide input message
+ * \param const uint32_t * prev_hash : IN - pointer to the initial hash
+ */
+__attribute__((target("sha,sse4.1")))
+void SHA1_niCompress(uint32_t * hash_ptr, const uint32_t * message, const uint32_t * prev_hash)
+{
+	/**
+	 * The SHA-NI instructions expect hash A and the first word of each group of 4 in the highest lane:
+	 *   abcd = [D, C, B, A], e = [0, 0, 0, E], msg = [W3, W2, W1, W0]
+	 * The message words are already Big Endian values, so only the order of the 4 words is reversed (0x1B).
+	 */
+	__m128i abcd = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i*)prev_hash), 0x1B);
+	__m128i e0   = _mm_set_epi32((int)prev_hash[SHA1_HASH_E], 0, 0, 0);
+	__m128i e1;
+
+	const __m128i abcdSave = abcd;
+	const __m128i e0Save   = e0;
+
+	__m128i msg0 = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i*)&message[0]),  0x1B);
+	__m128i msg1 = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i*)&message[4]),  0x1B);
+	__m128i msg2 = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i*)&message[8]),  0x1B);
+	__m128i msg3 = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i*)&message[12]), 0x1B);
+
+	//rounds 0 .. 3
+	e0   = _mm_add_epi32(e0, msg0);
+	e1   = abcd;
+	abcd = _mm_sha1rnds4_epu32(abcd, e0, 0);
+
+	//rounds 4 .. 7
+	e1   = _mm_sha1nexte_epu32(e1, msg1);
+	e0   = abcd;
+	abcd = _mm_sha1rnds4_epu32(abcd, e1, 0);
+	msg0 = _mm_sha1msg1_epu32(msg0, msg1);
+
+	//rounds 8 .. 11
+	e0   = _mm_sha1nexte_epu32(e0, msg2);
+	e1   = abcd;
+	abcd = _mm_sha1rnds4_epu32(abcd, e0, 0);
+	msg1 = _mm_sha1msg1_epu32(msg1, msg2);
+	msg0 = _mm_xor_si128(msg0, msg2);
+
+	//rounds 12 .. 15
+	e1   = _mm_sha1nexte_epu32(e1, msg3);
+	e0   = abcd;
+	msg0 = _mm_sha1msg2_epu32(msg0, msg3);
+	abcd = _mm_sha1rnds4_epu32(abcd, e1, 0);
+	msg2 = _mm_sha1msg1_epu32(msg2, msg3);
+	msg1 = _mm_xor_si128(msg1, msg3);
+
+	//rounds 16 .. 19: stage 1
+	SHA1_NI_FOUR_ROUNDS(e0, e1, msg0, msg1, msg2, msg3, 0);
+
+	//rounds 20 .. 39: stage 2
+	SHA1_NI_FOUR_ROUNDS(e1, e0, msg1, msg2, msg3, msg0, 1);
+	SHA1_NI_FOUR_ROUNDS(e0, e1, msg2, msg3, msg0, msg1, 1);
+	SHA1_NI_FOUR_ROUNDS(e1, e0, msg3, msg0, msg1, msg2, 1);
+	SHA1_NI_FOUR_ROUNDS(e0, e1, msg0, msg1, msg2, msg3, 1);
+	SHA1_NI_FOUR_ROUNDS(e1, e0, msg1, msg2, msg3, msg0, 1);
+
+	//rounds 40 .. 59: stage 3
+	SHA1_NI_FOUR_ROUNDS(e0, e1, msg2, msg3, msg0, msg1, 2);
+	SHA1_NI_FOUR_ROUNDS(e1, e0, msg3, msg0, msg1, msg2, 2);
+	SHA1_NI_FOUR_ROUNDS(e0, e1, msg0, msg1, msg2, msg3, 2);
+	SHA1_NI_FOUR_ROUNDS(e1, e0, msg1, msg2, msg3, msg0, 2);
+	SHA1_NI_FOUR_ROUNDS(e0, e1, msg2, msg3, msg0, msg1, 2);
+
+	//rounds 60 .. 67: stage 4
+	SHA1_NI_FOUR_ROUNDS(e1, e0, msg3, msg0, msg1, msg2, 3);
+	SHA1_NI_FOUR_ROUNDS(e0, e1, msg0, msg1, msg2, msg3, 3);
+
+	//rounds 68 .. 71: the schedule of W[76] .. W[79] only needs sha1msg2 from here on
+	e1   = _mm_sha1nexte_epu32(e1, msg1);
+	e0   = abcd;
+	msg2 = _mm_sha1msg2_epu32(msg2, msg1);
+	abcd = _mm_sha1rnds4_epu32(abcd, e1, 3);
+	msg3 = _mm_xor_si128(msg3, msg1);
+
+	//rounds 72 .. 75
+	e0   = _mm_sha1nexte_epu32(e0, msg2);
+	e1   = abcd;
+	msg3 = _mm_sha1msg2_epu32(msg3, msg2);
+	abcd = _mm_sha1rnds4_epu32(abcd, e0, 3);
+
+	//rounds 76 .. 79
+	e1   = _mm_sha1nexte_epu32(e1, msg3);
+	e0   = abcd;
+	abcd = _mm_sha1rnds4_epu32(abcd, e1, 3);
+
+	//compute final hash values for current 512-bit block
+	e0   = _mm_sha1nexte_epu32(e0, e0Save);
+	abcd = _mm_add_epi32(abcd, abcdSave);
+
+	_mm_storeu_si128((__m128i*)hash_ptr, _mm_shuffle_epi32(abcd, 0x1B));
+	hash_ptr[SHA1_HASH_E] = (uint32_t)_mm_extract_epi32(e0, 3);
+}
+
+#else
+
+/**
+ * \brief Compression Function built on the x86 SHA extensions.
+ *
+ * Not an x86 target: SHA1_niIsSupported() always returns FALSE, this is only the portable fallback.
+ *
+ * \param uint32_t * hash_ptr : OUT - pointer to the processed hash
+ * \param const uint32_t * message : IN - the pre-processed 512-bit wide input message
+ * \param const uint32_t * prev_hash : IN - pointer to the initial hash
+ */
+void SHA1_niCompress(uint32_t * hash_ptr, const uint32_t * message, const uint32_t * prev_hash)
+{
+	SHA1_compressUnrolled(hash_ptr, message, prev_hash);
+}
+
+#endif /* SHA1_NI_ENABLE */
@@ -0,0 +1,73 @@
+/**
+* \file   sha1_ni.h
+* \author Trung Tin Nguyen (1120436), and Dung Anh Huynh Pham (764527)
+* \date   17.10.2026
+*
+* \brief SHA-1 Compression Function built on the x86 SHA extensions (SHA-NI)
+*
+* This file contains API of the SHA-NI Compression Function (sha1rnds4, sha1nexte, sha1msg1, sha1msg2).
+* It has the same contract as sha_1(). Whether the CPU supports it is checked once at start-up through
+* CPUID; on CPUs without SHA-NI (and on non-x86 targets) the portable unrolled Compression Function is used.
+*
+* \note <notes>
+* \todo <todos>
+* \warning <warnings, e.g. dependencies, order of execution etc.>
+*
+*  Changelog:\n
+*  - <version; data of change; author>
+*            - <description of the change>
+*
+* \copyright Copyright 2023
+* Department of electrical engineering and information technology, Hochschule Darmstadt - University of applied sciences (h_da). All Rights Reserved.
+* Permission to use, copy, modify, and distribute this software and its documentation for educational, and research purposes in the context of non-commercial
+* (unless permitted by h_da) and official h_da projects, is hereby granted for enrolled students of h_da, provided that the above copyright notice,
+* this paragraph and the following paragraph appear in all copies, modifications, and distributions.
+*
+* Contact Prof.Dr. C. Jakob, christian.jakob@h-da.de, Birkenweg 8 64295 Darmstadt - GERMANY for commercial requests.
+*
+* \warning This software is a PROTOTYPE version and is not designed or intended for use in production, especially not for safety-critical applications!
+* The user represents and warrants that it will NOT use or redistribute the Software for such purposes.
+* This prototype is for research purposes only. This software is provided "AS IS," without a warranty of any kind.
+**/
+
+#ifndef SHA1_NI_H_
+#define SHA1_NI_H_
+
+#include "global.h"
+
+/*****************************************************************************/
+/* API functions                                                             */
+/*****************************************************************************/
+
+/**
+ * \brief Checks through CPUID if the CPU supports the SHA extensions (and SSSE3/SSE4.1 used next to them).
+ *
+ * \return TRUE if SHA1_niCompress() can be called on this CPU, otherwise FALSE
+ */
+boolean_t SHA1_niIsSupported(void);
+
+/**
+ * \brief Compression Function built on the x86 SHA extensions.
+ *
+ * Must only be called if SHA1_niIsSupported() returns TRUE.
+ * hash_ptr may point to the same array as prev_hash.
+ *
+ * \param uint32_t * hash_ptr : OUT - pointer to the processed hash
+ * \param const uint32_t * message : IN - the pre-processed 512-bit wide input message
+ * \param const uint32_t * prev_hash : IN - pointer to the initial hash
+ */
+void SHA1_niCompress(uint32_t * hash_ptr, const uint32_t * message, const uint32_t * prev_hash);
+
+/**
+ * \brief Compression Function chosen at start-up: SHA1_niCompress() if the CPU supports it,
+ * 		  otherwise SHA1_compressUnrolled().
+ *
+ * This is what sha_1() calls when SHA1_CONFIG_COMPRESSION is SHA1_COMPRESSION_X86_SHA_NI.
+ *
+ * \param uint32_t * hash_ptr : OUT - pointer to the processed hash
+ * \param const uint32_t * message : IN - the pre-processed 512-bit wide input message
+ * \param const uint32_t * prev_hash : IN - pointer to the initial hash
+ */
+void SHA1_niCompressDispatch(uint32_t * hash_ptr, const uint32_t * message, const uint32_t * prev_hash);
+
+#endif /* SHA1_NI_H_ */
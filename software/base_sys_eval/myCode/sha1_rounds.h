@@ -0,0 +1,124 @@
+/**
+* \file   sha1_rounds.h
+* \author Trung Tin Nguyen (1120436), and Dung Anh Huynh Pham (764527)
+* \date   17.10.2026
+*
+* \brief round macros of the unrolled SHA-1 Compression Function
+*
+* This file contains the macros that build the unrolled Compression Function. It is only included by
+* the SHA-1 implementation files ("sha1.c", "sha1_mb.c"), not by the users of the SHA-1 API.
+*
+* The macros only use the operators +, ^, &, |, <<, >>, so they work both on uint32_t values and on
+* GCC vector types of uint32_t lanes (one message per lane).
+*
+* \note <notes>
+* \todo <todos>
+* \warning <warnings, e.g. dependencies, order of execution etc.>
+*
+*  Changelog:\n
+*  - <version; data of change; author>
+*            - <description of the change>
+*
+* \copyright Copyright 2023
+* Department of electrical engineering and information technology, Hochschule Darmstadt - University of applied sciences (h_da). All Rights Reserved.
+* Permission to use, copy, modify, and distribute this software and its documentation for educational, and research purposes in the context of non-commercial
+* (unless permitted by h_da) and official h_da projects, is hereby granted for enrolled students of h_da, provided that the above copyright notice,
+* this paragraph and the following paragraph appear in all copies, modifications, and distributions.
+*
+* Contact Prof.Dr. C. Jakob, christian.jakob@h-da.de, Birkenweg 8 64295 Darmstadt - GERMANY for commercial requests.
+*
+* \warning This software is a PROTOTYPE version and is not designed or intended for use in production, especially not for safety-critical applications!
+* The user represents and warrants that it will NOT use or redistribute the Software for such purposes.
+* This prototype is for research purposes only. This software is provided "AS IS," without a warranty of any kind.
+**/
+
+#ifndef SHA1_ROUNDS_H_
+#define SHA1_ROUNDS_H_
+
+/*****************************************************************************/
+/* Global pre-processor symbols/macros and type declarations                 */
+/*****************************************************************************/
+
+//####################### Defines/Macros
+
+/**
+ * \brief ROTL on a uint32_t value, numOfShiftBits must be between 1 and 31.
+ */
+#define SHA1_ROTL32(uint32Value, numOfShiftBits)	(((uint32Value) << (numOfShiftBits)) | ((uint32Value) >> (32 - (numOfShiftBits))))
+
+/**
+ * \brief Cheaper forms of the kernel functions, used by the unrolled Compression Function.
+ *
+ * - stage 1 (Ch):  (x & y) ^ (~x & z)           = z ^ (x & (y ^ z))          => 3 instead of 4 operations
+ * - stage 3 (Maj): (x & y) ^ (x & z) ^ (y & z)  = (x & y) | (z & (x | y))    => 4 instead of 5 operations
+ * - stage 2 and 4 (Parity): x ^ y ^ z
+ */
+#define SHA1_KERNEL_CH(x, y, z)			((z) ^ ((x) & ((y) ^ (z))))
+#define SHA1_KERNEL_PARITY(x, y, z)		((x) ^ (y) ^ (z))
+#define SHA1_KERNEL_MAJ(x, y, z)		(((x) & (y)) | ((z) & ((x) | (y))))
+
+/**
+ * \brief One round of the unrolled Compression Function.
+ *
+ * Instead of shifting the 5 hash words through an array, the caller renames them:
+ * the new hash A is accumulated into e, and b is rotated in place to become the new hash C.
+ */
+#define SHA1_UNROLLED_ROUND(a, b, c, d, e, kernel, constantK, word)							\
+	do {																					\
+		(e) += SHA1_ROTL32((a), 5) + kernel((b), (c), (d)) + (constantK) + (word);			\
+		(b)  = SHA1_ROTL32((b), 30);														\
+	} while(0)
+
+/**
+ * \brief Five rounds of the unrolled Compression Function, after which the hash words are back in place.
+ */
+#define SHA1_UNROLLED_FIVE_ROUNDS(kernel, constantK, roundIndex)								\
+	do {																					\
+		SHA1_UNROLLED_ROUND(a, b, c, d, e, kernel, constantK, W(roundIndex));				\
+		SHA1_UNROLLED_ROUND(e, a, b, c, d, kernel, constantK, W((roundIndex) + 1));			\
+		SHA1_UNROLLED_ROUND(d, e, a, b, c, kernel, constantK, W((roundIndex) + 2));			\
+		SHA1_UNROLLED_ROUND(c, d, e, a, b, kernel, constantK, W((roundIndex) + 3));			\
+		SHA1_UNROLLED_ROUND(b, c, d, e, a, kernel, constantK, W((roundIndex) + 4));			\
+	} while(0)
+
+/**
+ * \brief The 80 rounds of the unrolled Compression Function, 4 stages x 20 rounds.
+ *
+ * Works on the hash words a .. e of the caller and takes word t of the message schedule from W(t), which the caller
+ * defines: the expanded 80-word array or SHA1_ROLLING_WORD().
+ */
+#define SHA1_UNROLLED_EIGHTY_ROUNDS()														\
+	do {																					\
+		SHA1_UNROLLED_FIVE_ROUNDS(SHA1_KERNEL_CH, SHA1_K_STAGE_1, 0);						\
+		SHA1_UNROLLED_FIVE_ROUNDS(SHA1_KERNEL_CH, SHA1_K_STAGE_1, 5);						\
+		SHA1_UNROLLED_FIVE_ROUNDS(SHA1_KERNEL_CH, SHA1_K_STAGE_1, 10);						\
+		SHA1_UNROLLED_FIVE_ROUNDS(SHA1_KERNEL_CH, SHA1_K_STAGE_1, 15);						\
+		SHA1_UNROLLED_FIVE_ROUNDS(SHA1_KERNEL_PARITY, SHA1_K_STAGE_2, 20);					\
+		SHA1_UNROLLED_FIVE_ROUNDS(SHA1_KERNEL_PARITY, SHA1_K_STAGE_2, 25);					\
+		SHA1_UNROLLED_FIVE_ROUNDS(SHA1_KERNEL_PARITY, SHA1_K_STAGE_2, 30);					\
+		SHA1_UNROLLED_FIVE_ROUNDS(SHA1_KERNEL_PARITY, SHA1_K_STAGE_2, 35);					\
+		SHA1_UNROLLED_FIVE_ROUNDS(SHA1_KERNEL_MAJ, SHA1_K_STAGE_3, 40);						\
+		SHA1_UNROLLED_FIVE_ROUNDS(SHA1_KERNEL_MAJ, SHA1_K_STAGE_3, 45);						\
+		SHA1_UNROLLED_FIVE_ROUNDS(SHA1_KERNEL_MAJ, SHA1_K_STAGE_3, 50);						\
+		SHA1_UNROLLED_FIVE_ROUNDS(SHA1_KERNEL_MAJ, SHA1_K_STAGE_3, 55);						\
+		SHA1_UNROLLED_FIVE_ROUNDS(SHA1_KERNEL_PARITY, SHA1_K_STAGE_4, 60);					\
+		SHA1_UNROLLED_FIVE_ROUNDS(SHA1_KERNEL_PARITY, SHA1_K_STAGE_4, 65);					\
+		SHA1_UNROLLED_FIVE_ROUNDS(SHA1_KERNEL_PARITY, SHA1_K_STAGE_4, 70);					\
+		SHA1_UNROLLED_FIVE_ROUNDS(SHA1_KERNEL_PARITY, SHA1_K_STAGE_4, 75);					\
+	} while(0)
+
+/**
+ * \brief Word t of the message schedule, computed in a 16-word circular buffer.
+ *
+ * Word t is stored at index (t % 16). From 16 to 79, W[t] replaces W[t - 16] right before round t uses it:
+ *   W[t] = ROTL1(W[t-3] ^ W[t-8] ^ W[t-14] ^ W[t-16])
+ * roundIndex must be a constant, so the condition and the indexes are resolved at compile time.
+ */
+#define SHA1_ROLLING_WORD(w, roundIndex)														\
+	(((roundIndex) < 16) ? (w)[(roundIndex) & 15] :											\
+		((w)[(roundIndex) & 15] = SHA1_ROTL32((w)[((roundIndex) - 3) & 15] ^					\
+											  (w)[((roundIndex) - 8) & 15] ^					\
+											  (w)[((roundIndex) - 14) & 15] ^					\
+											  (w)[(roundIndex) & 15], 1)))
+
+#endif /* SHA1_ROUNDS_H_ */
@@ -0,0 +1,86 @@
+/**
+* \file   timer.c
+* \author Trung Tin Nguyen (1120436), and Dung Anh Huynh Pham (764527)
+* \date   17.10.2026
+*
+* \brief Cycle counter for benchmarks, based on the sys_timer of the DECA board
+*
+* \copyright Copyright 2023
+* Department of electrical engineering and information technology, Hochschule Darmstadt - University of applied sciences (h_da). All Rights Reserved.
+* Permission to use, copy, modify, and distribute this software and its documentation for educational, and research purposes in the context of non-commercial
+* (unless permitted by h_da) and official h_da projects, is hereby granted for enrolled students of h_da, provided that the above copyright notice,
+* this paragraph and the following paragraph appear in all copies, modifications, and distributions.
+*
+* Contact Prof.Dr. C. Jakob, christian.jakob@h-da.de, Birkenweg 8 64295 Darmstadt - GERMANY for commercial requests.
+*
+* \warning This software is a PROTOTYPE version and is not designed or intended for use in production, especially not for safety-critical applications!
+* The user represents and warrants that it will NOT use or redistribute the Software for such purposes.
+* This prototype is for research purposes only. This software is provided "AS IS," without a warranty of any kind.
+*/
+
+
+/*****************************************************************************/
+/* Include files                                                             */
+/*****************************************************************************/
+#if !defined(__nios2__)
+#include <time.h>	//for clock_gettime()
+#endif
+
+#include "timer.h"
+
+
+/*****************************************************************************/
+/* Function implementation - global ('extern') and local ('static')          */
+/*****************************************************************************/
+
+/**
+ * \brief Starts sys_timer as a free-running counter over the full 32-bit period, without interrupt.
+ */
+void TIMER_init(void)
+{
+#if defined(__nios2__)
+
+	//writing the period stops the counter, so stop it first and start it again afterwards
+	SYS_TIMER.CONTROL_REG = TIMER_CONTROL_STOP;
+	SYS_TIMER.PERIODL_REG = 0xFFFF;
+	SYS_TIMER.PERIODH_REG = 0xFFFF;
+
+	//clear a pending time-out, then run continuously without interrupt
+	SYS_TIMER.STATUS_REG = 0;
+	SYS_TIMER.CONTROL_REG = TIMER_CONTROL_CONT | TIMER_CONTROL_START;
+
+#endif
+}
+
+/**
+ * \brief Reads the counter.
+ *
+ * The value counts UP (the hardware counts down, it is inverted here),
+ * so the cycles between two reads are simply (end - start), also across one wrap-around.
+ *
+ * \return the current counter value, in cycles
+ */
+uint32_t TIMER_getCycles(void)
+{
+#if defined(__nios2__)
+
+	//latch the counter, then read both halves of the snapshot
+	SYS_TIMER.SNAPL_REG = 0;
+
+	uint32_t counter = ((uint32_t)(SYS_TIMER.SNAPH_REG & 0xFFFF) << 16) | (SYS_TIMER.SNAPL_REG & 0xFFFF);
+
+	return ~counter;
+
+#else
+
+	struct timespec now;
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+
+	//nanoseconds at TIMER_FREQ, only the lower 32 bit are kept like on the board
+	uint64_t nanoseconds = ((uint64_t)now.tv_sec * 1000000000u) + (uint64_t)now.tv_nsec;
+
+	return (uint32_t)((nanoseconds * (TIMER_FREQ / 1000000u)) / 1000u);
+
+#endif
+}
@@ -0,0 +1,99 @@
+/**
+* \file   timer.h
+* \author Trung Tin Nguyen (1120436), and Dung Anh Huynh Pham (764527)
+* \date   17.10.2026
+*
+* \brief Cycle counter for benchmarks, based on the sys_timer of the DECA board
+*
+* The BSP has no timestamp driver (ALT_TIMESTAMP_CLK is none) and no system clock driver (ALT_SYS_CLK is none),
+* so sys_timer is free. It is used as a free-running 32-bit down counter, clocked with the 50 MHz CPU clock:
+* one timer tick is one CPU cycle. It wraps around after about 86 seconds.
+*
+* On the host, the cycles are derived from CLOCK_MONOTONIC at the same TIMER_FREQ.
+*
+* \note <notes>
+* \todo <todos>
+* \warning TIMER_init() reprograms sys_timer, do not use it together with a HAL driver on that timer.
+*
+*  Changelog:\n
+*  - <version; data of change; author>
+*            - <description of the change>
+*
+* \copyright Copyright 2023
+* Department of electrical engineering and information technology, Hochschule Darmstadt - University of applied sciences (h_da). All Rights Reserved.
+* Permission to use, copy, modify, and distribute this software and its documentation for educational, and research purposes in the context of non-commercial
+* (unless permitted by h_da) and official h_da projects, is hereby granted for enrolled students of h_da, provided that the above copyright notice,
+* this paragraph and the following paragraph appear in all copies, modifications, and distributions.
+*
+* Contact Prof.Dr. C. Jakob, christian.jakob@h-da.de, Birkenweg 8 64295 Darmstadt - GERMANY for commercial requests.
+*
+* \warning This software is a PROTOTYPE version and is not designed or intended for use in production, especially not for safety-critical applications!
+* The user represents and warrants that it will NOT use or redistribute the Software for such purposes.
+* This prototype is for research purposes only. This software is provided "AS IS," without a warranty of any kind.
+**/
+
+#ifndef MYCODE_TIMER_H_
+#define MYCODE_TIMER_H_
+
+#include "global.h"
+#include "platform.h"
+
+
+/*****************************************************************************/
+/* Global pre-processor symbols/macros and type declarations                 */
+/*****************************************************************************/
+
+/**
+ * \brief Frequency of the counter, the same as the CPU clock.
+ */
+#if defined(__nios2__)
+#define TIMER_FREQ		SYS_TIMER_FREQ		/**< in Hz */
+#else
+#define TIMER_FREQ		50000000u			/**< in Hz, the clock of the DECA board */
+#endif
+
+#if defined(__nios2__)
+
+//altera_avalon_timer unit structure, only the lower 16 bit of each register are used
+typedef struct {
+	__IO alt_u32 STATUS_REG;
+	__IO alt_u32 CONTROL_REG;
+	__IO alt_u32 PERIODL_REG;
+	__IO alt_u32 PERIODH_REG;
+	__IO alt_u32 SNAPL_REG;			//writing any value latches the counter into SNAPL/SNAPH
+	__IO alt_u32 SNAPH_REG;
+} TIMER_TYPE;
+
+//bits of CONTROL_REG
+#define TIMER_CONTROL_ITO		(1u << 0)	/**< interrupt on time-out */
+#define TIMER_CONTROL_CONT		(1u << 1)	/**< reload and continue on time-out */
+#define TIMER_CONTROL_START		(1u << 2)	/**< write 1 to start */
+#define TIMER_CONTROL_STOP		(1u << 3)	/**< write 1 to stop */
+
+//Base address of sys_timer SYS_TIMER_BASE in "system.h"
+//MSB is set to one to bypass the data cache
+#define SYS_TIMER (*((TIMER_TYPE *) (SYS_TIMER_BASE | 0x80000000u)))
+
+#endif
+
+
+/*****************************************************************************/
+/* API functions                                                             */
+/*****************************************************************************/
+
+/**
+ * \brief Starts sys_timer as a free-running counter over the full 32-bit period, without interrupt.
+ */
+void TIMER_init(void);
+
+/**
+ * \brief Reads the counter.
+ *
+ * The value counts UP (the hardware counts down, it is inverted here),
+ * so the cycles between two reads are simply (end - start), also across one wrap-around.
+ *
+ * \return the current counter value, in cycles
+ */
+uint32_t TIMER_getCycles(void);
+
+#endif /* MYCODE_TIMER_H_ */
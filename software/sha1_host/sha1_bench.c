@@ -0,0 +1,339 @@
+/**
+* \file   sha1_bench.c
+* \author Trung Tin Nguyen (1120436), and Dung Anh Huynh Pham (764527)
+* \date   17.10.2026
+*
+* \brief Host benchmark of the SHA-1 library
+*
+* Measures every Compression Function on its own, then the whole APIs (SHA1_hashBuffer(), Packet Object,
+* multi-buffer engine) on the same data. Every result is one line of "key=value" pairs, e.g.
+*
+*   bench=compress-unrolled bytes=67108864 seconds=0.312 MB/s=215.1 ns/byte=4.65
+*
+* The proof-of-work search (SHA1_powSearch(), SHA1_powSearchParallel()) is measured in nonces per second, with a
+* target that no hash meets, so every nonce of the range is tried:
+*
+*   bench=pow-search-threads-4 nonces=1048576 seconds=0.112 nonces/s=9362285
+*
+* Usage: sha1_bench [MiB per run, default 64]
+*
+* \copyright Copyright 2023
+* Department of electrical engineering and information technology, Hochschule Darmstadt - University of applied sciences (h_da). All Rights Reserved.
+* Permission to use, copy, modify, and distribute this software and its documentation for educational, and research purposes in the context of non-commercial
+* (unless permitted by h_da) and official h_da projects, is hereby granted for enrolled students of h_da, provided that the above copyright notice,
+* this paragraph and the following paragraph appear in all copies, modifications, and distributions.
+*
+* Contact Prof.Dr. C. Jakob, christian.jakob@h-da.de, Birkenweg 8 64295 Darmstadt - GERMANY for commercial requests.
+*
+* \warning This software is a PROTOTYPE version and is not designed or intended for use in production, especially not for safety-critical applications!
+* The user represents and warrants that it will NOT use or redistribute the Software for such purposes.
+* This prototype is for research purposes only. This software is provided "AS IS," without a warranty of any kind.
+*/
+
+/*****************************************************************************/
+/* Include files                                                             */
+/*****************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>		//for the usage of malloc
+#include <string.h>		//for the usage of memset()
+#include <time.h>		//for clock_gettime()
+#include <unistd.h>		//for sysconf()
+
+#include "global.h"
+#include "sha1.h"
+#include "sha1_config.h"
+#include "sha1_mb.h"
+#include "sha1_ni.h"
+#include "msg.h"
+
+
+/*****************************************************************************/
+/* Local pre-processor symbols/macros ('#define')                            */
+/*****************************************************************************/
+
+#define BENCH_DEFAULT_SIZE_IN_MIB	64			/**< in MiB */
+#define BENCH_PACKET_SIZE_IN_MIB	4			/**< in MiB, the Packet Object keeps the whole message in memory */
+#define BENCH_MB_JOB_SIZE			4096		/**< in bytes, message length of the multi-buffer run */
+#define BENCH_POW_NONCES_PER_MIB	16384		/**< nonces of the proof-of-work run per MiB, one block each */
+
+
+/*****************************************************************************/
+/* Local type definitions ('typedef')                                        */
+/*****************************************************************************/
+
+/**
+ * \brief Signature shared by sha_1() and all Compression Functions.
+ */
+typedef void (*BENCH_compress_t)(uint32_t * hash_ptr, const uint32_t * message, const uint32_t * prev_hash);
+
+
+/*****************************************************************************/
+/* Local variable definitions ('static')                                     */
+/*****************************************************************************/
+
+//hash of the last run, printed so that the compiler cannot drop the work
+static uint32_t BENCH_sink = 0;
+
+
+/*****************************************************************************/
+/* Local function prototypes ('static')                                      */
+/*****************************************************************************/
+
+static float64_t BENCH_now(void);
+static void BENCH_report(const char* name, uint64_t numOfBytes, float64_t seconds);
+static void BENCH_compress(const char* name, BENCH_compress_t compress, const uint8_t* data, uint64_t length);
+static void BENCH_hashBuffer(const uint8_t* data, uint64_t length);
+static void BENCH_packet(const uint8_t* data, uint64_t length);
+static void BENCH_multiBuffer(const uint8_t* data, uint64_t length, uint32_t numOfLanes);
+static void BENCH_proofOfWork(uint32_t numOfNonces, uint32_t numOfThreads);
+
+
+/*****************************************************************************/
+/* Function implementation - global ('extern') and local ('static')          */
+/*****************************************************************************/
+
+int main(int argc, char* argv[])
+{
+	uint64_t sizeInMiB = BENCH_DEFAULT_SIZE_IN_MIB;
+
+	if(argc > 1)
+	{
+		sizeInMiB = strtoull(argv[1], NULL, 10);
+		if(sizeInMiB == 0)
+		{
+			fprintf(stderr, "usage: %s [MiB per run, default %d]\n", argv[0], BENCH_DEFAULT_SIZE_IN_MIB);
+			return EXIT_FAILURE;
+		}
+	}
+
+	uint64_t length = sizeInMiB << 20;
+	uint8_t* data = (uint8_t*)malloc(length);
+	if(data == NULL)
+	{
+		fprintf(stderr, "cannot allocate %llu MiB\n", (unsigned long long)sizeInMiB);
+		return EXIT_FAILURE;
+	}
+
+	for(uint64_t i = 0; i < length; i++)
+	{
+		data[i] = (uint8_t)((i * 2654435761u) >> 24);
+	}
+
+	printf("# sha_1() uses Compression Function %d, SHA-NI %s, multi-buffer lanes %u\n",
+			SHA1_CONFIG_COMPRESSION,
+			SHA1_niIsSupported() ? "supported" : "not supported",
+			(unsigned int)SHA1_mbGetNumOfLanes());
+
+	BENCH_compress("compress-stage-dispatch", SHA1_compressStageDispatch, data, length);
+	BENCH_compress("compress-unrolled", SHA1_compressUnrolled, data, length);
+	if(TRUE == SHA1_niIsSupported())
+	{
+		BENCH_compress("compress-sha-ni", SHA1_niCompress, data, length);
+	}
+
+	BENCH_hashBuffer(data, length);
+	BENCH_packet(data, (length < ((uint64_t)BENCH_PACKET_SIZE_IN_MIB << 20)) ? length : ((uint64_t)BENCH_PACKET_SIZE_IN_MIB << 20));
+
+	BENCH_multiBuffer(data, length, 1);
+	for(uint32_t numOfLanes = 4; numOfLanes <= SHA1_mbGetNumOfLanes(); numOfLanes *= 2)
+	{
+		BENCH_multiBuffer(data, length, numOfLanes);
+	}
+
+	//one thread on the CPU, then as many as there are CPUs
+	uint32_t numOfCpus = (uint32_t)sysconf(_SC_NPROCESSORS_ONLN);
+	uint32_t numOfNonces = (uint32_t)(sizeInMiB * BENCH_POW_NONCES_PER_MIB);
+
+	BENCH_proofOfWork(numOfNonces, 0);
+	BENCH_proofOfWork(numOfNonces, 1);
+	for(uint32_t numOfThreads = 2; numOfThreads < numOfCpus; numOfThreads *= 2)
+	{
+		BENCH_proofOfWork(numOfNonces, numOfThreads);
+	}
+	if(numOfCpus > 1)
+	{
+		BENCH_proofOfWork(numOfNonces, numOfCpus);
+	}
+
+	printf("# sink=%08x\n", (unsigned int)BENCH_sink);
+
+	free(data);
+
+	return EXIT_SUCCESS;
+}
+
+/**
+ * \brief Monotonic wall-clock time.
+ *
+ * \return time in seconds
+ */
+static float64_t BENCH_now(void)
+{
+	struct timespec now;
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+
+	return (float64_t)now.tv_sec + ((float64_t)now.tv_nsec * 1e-9);
+}
+
+/**
+ * \brief Prints one result line.
+ *
+ * \param const char* name : IN - name of the benchmark
+ * \param uint64_t numOfBytes : IN - number of hashed bytes
+ * \param float64_t seconds : IN - time of the run
+ */
+static void BENCH_report(const char* name, uint64_t numOfBytes, float64_t seconds)
+{
+	printf("bench=%s bytes=%llu seconds=%.3f MB/s=%.1f ns/byte=%.2f\n",
+			name,
+			(unsigned long long)numOfBytes,
+			seconds,
+			((float64_t)numOfBytes / seconds) * 1e-6,
+			(seconds * 1e9) / (float64_t)numOfBytes);
+}
+
+/**
+ * \brief Runs a Compression Function over all blocks of the data, without padding and byte order conversion.
+ *
+ * \param const char* name : IN - name of the benchmark
+ * \param BENCH_compress_t compress : IN - the Compression Function
+ * \param const uint8_t* data : IN - the data, word-aligned (malloc)
+ * \param uint64_t length : IN - length of the data, in bytes
+ */
+static void BENCH_compress(const char* name, BENCH_compress_t compress, const uint8_t* data, uint64_t length)
+{
+	uint32_t hash[SHA1_NUM_OF_HASH_WORDS_PER_BLOCK] =
+		{SHA1_INIT_HASH_A, SHA1_INIT_HASH_B, SHA1_INIT_HASH_C, SHA1_INIT_HASH_D, SHA1_INIT_HASH_E};
+	uint64_t numOfBlocks = length / SHA1_BLOCK_SIZE_IN_BYTES;
+
+	float64_t start = BENCH_now();
+	for(uint64_t blockIndex = 0; blockIndex < numOfBlocks; blockIndex++)
+	{
+		compress(hash, (const uint32_t*)&data[blockIndex * SHA1_BLOCK_SIZE_IN_BYTES], hash);
+	}
+	float64_t seconds = BENCH_now() - start;
+
+	BENCH_sink ^= hash[SHA1_HASH_A];
+	BENCH_report(name, numOfBlocks * SHA1_BLOCK_SIZE_IN_BYTES, seconds);
+}
+
+/**
+ * \brief Hashes the data as one message with SHA1_hashBuffer().
+ *
+ * \param const uint8_t* data : IN - the data
+ * \param uint64_t length : IN - length of the data, in bytes
+ */
+static void BENCH_hashBuffer(const uint8_t* data, uint64_t length)
+{
+	uint32_t hash[SHA1_NUM_OF_HASH_WORDS_PER_BLOCK];
+
+	float64_t start = BENCH_now();
+	SHA1_hashBuffer(hash, data, length);
+	float64_t seconds = BENCH_now() - start;
+
+	BENCH_sink ^= hash[SHA1_HASH_A];
+	BENCH_report("hash-buffer", length, seconds);
+}
+
+/**
+ * \brief Hashes the data as one message with the Message and SHA-1 Packet Objects, like main.c does.
+ *
+ * \param const uint8_t* data : IN - the data
+ * \param uint64_t length : IN - length of the data, in bytes
+ */
+static void BENCH_packet(const uint8_t* data, uint64_t length)
+{
+	MSG_message_t message;
+	SHA1_packet_t packet;
+
+	float64_t start = BENCH_now();
+
+	MSG_init(&message, (const char*)data, (uint32_t)length);
+	SHA1_init(&packet, &message);
+
+	SHA1_processPacket(&packet);
+
+	float64_t seconds = BENCH_now() - start;
+
+	BENCH_sink ^= packet.m_512bit_block[packet.m_numOf512bitBlocks - 1].m_outputHash[SHA1_HASH_A];
+	BENCH_report("packet", length, seconds);
+
+	SHA1_freeMemory(&packet);
+	MSG_freeMemory(&message);
+}
+
+/**
+ * \brief Hashes the data as independent messages of BENCH_MB_JOB_SIZE bytes with the multi-buffer engine.
+ *
+ * \param const uint8_t* data : IN - the data
+ * \param uint64_t length : IN - length of the data, in bytes
+ * \param uint32_t numOfLanes : IN - kernel of the multi-buffer engine
+ */
+static void BENCH_multiBuffer(const uint8_t* data, uint64_t length, uint32_t numOfLanes)
+{
+	uint64_t numOfJobs = length / BENCH_MB_JOB_SIZE;
+	SHA1_mbJob_t* jobs = (SHA1_mbJob_t*)malloc(numOfJobs * sizeof(SHA1_mbJob_t));
+	char name[32];
+
+	for(uint64_t jobIndex = 0; jobIndex < numOfJobs; jobIndex++)
+	{
+		jobs[jobIndex].m_data = &data[jobIndex * BENCH_MB_JOB_SIZE];
+		jobs[jobIndex].m_length = BENCH_MB_JOB_SIZE;
+	}
+
+	float64_t start = BENCH_now();
+	SHA1_mbHashJobs(jobs, numOfJobs, numOfLanes);
+	float64_t seconds = BENCH_now() - start;
+
+	for(uint64_t jobIndex = 0; jobIndex < numOfJobs; jobIndex++)
+	{
+		BENCH_sink ^= jobs[jobIndex].m_hash[SHA1_HASH_A];
+	}
+
+	snprintf(name, sizeof(name), "multi-buffer-lanes-%u", (unsigned int)numOfLanes);
+	BENCH_report(name, numOfJobs * BENCH_MB_JOB_SIZE, seconds);
+
+	free(jobs);
+}
+
+/**
+ * \brief Searches a range of nonces of a hashcash-like stamp with a target that no hash meets.
+ *
+ * The prefix has 40 bytes, so each nonce costs one block from the midstate.
+ *
+ * \param uint32_t numOfNonces : IN - nonces to try
+ * \param uint32_t numOfThreads : IN - 0: SHA1_powSearch(), otherwise SHA1_powSearchParallel() with that many threads
+ */
+static void BENCH_proofOfWork(uint32_t numOfNonces, uint32_t numOfThreads)
+{
+	static const char prefix[] = "1:20:261017:fsoc@h-da.de::McMybZIhxKXu57";
+	SHA1_powJob_t job;
+	char name[32];
+
+	job.m_prefix = prefix;
+	job.m_prefixLength = sizeof(prefix) - 1;
+	job.m_firstNonce = 0;
+	job.m_numOfNonces = numOfNonces;
+	SHA1_powTargetMask(job.m_targetMask, 160);
+
+	float64_t start = BENCH_now();
+	if(0 == numOfThreads)
+	{
+		SHA1_powSearch(&job);
+		snprintf(name, sizeof(name), "pow-search");
+	}
+	else
+	{
+		SHA1_powSearchParallel(&job, numOfThreads);
+		snprintf(name, sizeof(name), "pow-search-threads-%u", (unsigned int)numOfThreads);
+	}
+	float64_t seconds = BENCH_now() - start;
+
+	BENCH_sink ^= job.m_numOfNoncesTried;
+	printf("bench=%s nonces=%u seconds=%.3f nonces/s=%.0f\n",
+			name,
+			(unsigned int)job.m_numOfNoncesTried,
+			seconds,
+			(float64_t)job.m_numOfNoncesTried / seconds);
+}
@@ -0,0 +1,689 @@
+/**
+* \file   sha1_selftest.c
+* \author Trung Tin Nguyen (1120436), and Dung Anh Huynh Pham (764527)
+* \date   17.10.2026
+*
+* \brief Host self-test of the SHA-1 library: known-answer tests on every API and Compression Function
+*
+* - FIPS PUB 180-1 / NIST vectors and the lab strings, hashed with the Packet Object (ASCII only), SHA1_hashBuffer(),
+*   the streaming context (in uneven pieces) and the multi-buffer engine (every lane width).
+* - SHA1_compressUnrolled(), SHA1_niCompress(), SHA1_niCompressDispatch() (SHA-NI if CPUID has it) and
+*   SHA1_compressCustomInstr() (on the C model of the custom instruction) against SHA1_compressStageDispatch() on
+*   random blocks.
+* - Several threads hash thousands of messages at the same time, to check that the library has no hidden shared state.
+*
+* Prints one "PASS <name>" or "FAIL <name>" line per check and returns 0 only if all checks pass.
+*
+* \copyright Copyright 2023
+* Department of electrical engineering and information technology, Hochschule Darmstadt - University of applied sciences (h_da). All Rights Reserved.
+* Permission to use, copy, modify, and distribute this software and its documentation for educational, and research purposes in the context of non-commercial
+* (unless permitted by h_da) and official h_da projects, is hereby granted for enrolled students of h_da, provided that the above copyright notice,
+* this paragraph and the following paragraph appear in all copies, modifications, and distributions.
+*
+* Contact Prof.Dr. C. Jakob, christian.jakob@h-da.de, Birkenweg 8 64295 Darmstadt - GERMANY for commercial requests.
+*
+* \warning This software is a PROTOTYPE version and is not designed or intended for use in production, especially not for safety-critical applications!
+* The user represents and warrants that it will NOT use or redistribute the Software for such purposes.
+* This prototype is for research purposes only. This software is provided "AS IS," without a warranty of any kind.
+*/
+
+/*****************************************************************************/
+/* Include files                                                             */
+/*****************************************************************************/
+#include <pthread.h>	//for the concurrency check
+#include <stdio.h>
+#include <stdlib.h>		//for the usage of malloc
+#include <string.h>		//for the usage of memcpy()
+
+#include "global.h"
+#include "sha1.h"
+#include "sha1_config.h"
+#include "sha1_mb.h"
+#include "sha1_ni.h"
+#include "msg.h"
+
+
+/*****************************************************************************/
+/* Local pre-processor symbols/macros ('#define')                            */
+/*****************************************************************************/
+
+#define SELFTEST_NUM_OF_RANDOM_BLOCKS		4096	/**< blocks per Compression Function check */
+#define SELFTEST_NUM_OF_THREADS				8		/**< threads of the concurrency check */
+#define SELFTEST_NUM_OF_MESSAGES			4096	/**< messages per thread of the concurrency check */
+#define SELFTEST_MAX_MESSAGE_LENGTH			1024	/**< in bytes */
+#define SELFTEST_POW_MAX_PREFIX_LENGTH		140		/**< prefixes of 0..140 bytes, 1 or 2 tail blocks, nonce across a block border */
+#define SELFTEST_POW_NUM_OF_NONCES			2048	/**< range of each prefix, about 8 hits at 8 zero bits */
+#define SELFTEST_POW_ZERO_BITS				8		/**< difficulty of the checks per prefix */
+#define SELFTEST_POW_LONG_ZERO_BITS			12		/**< difficulty of the check across many pieces, about one hit per piece */
+#define SELFTEST_POW_LONG_NUM_OF_NONCES		100000	/**< range of that check */
+
+
+/*****************************************************************************/
+/* Local type definitions ('typedef')                                        */
+/*****************************************************************************/
+
+/**
+ * \brief One known-answer test: m_pattern repeated m_numOfRepeats times.
+ */
+struct sSELFTEST_kat {
+  const char*	m_name;										/**< name printed in the PASS/FAIL line */
+  const char*	m_pattern;									/**< the message, or the part that is repeated */
+  uint32_t		m_patternLength;							/**< in bytes */
+  uint32_t		m_numOfRepeats;								/**< 1 for a plain message */
+  uint32_t		m_hash[SHA1_NUM_OF_HASH_WORDS_PER_BLOCK];	/**< the correct/expected hash */
+};
+typedef struct sSELFTEST_kat SELFTEST_kat_t;
+
+/**
+ * \brief Work of one thread in the concurrency check.
+ */
+struct sSELFTEST_thread {
+  uint32_t		m_threadIndex;								/**< selects the messages of the thread */
+  boolean_t		m_isCorrect;								/**< OUT - TRUE if every hash was correct */
+};
+typedef struct sSELFTEST_thread SELFTEST_thread_t;
+
+/**
+ * \brief Signature shared by sha_1() and all Compression Functions.
+ */
+typedef void (*SELFTEST_compress_t)(uint32_t * hash_ptr, const uint32_t * message, const uint32_t * prev_hash);
+
+
+/*****************************************************************************/
+/* Local variable definitions ('static')                                     */
+/*****************************************************************************/
+
+//FIPS PUB 180-1 Appendix A/B/C, the empty message, and the strings of the lab
+static const SELFTEST_kat_t SELFTEST_kats[] = {
+	{"empty", "", 0, 1,
+		{0xda39a3ee, 0x5e6b4b0d, 0x3255bfef, 0x95601890, 0xafd80709}},
+	{"abc", "abc", 3, 1,
+		{0xa9993e36, 0x4706816a, 0xba3e2571, 0x7850c26c, 0x9cd0d89d}},
+	{"nist-448bit", "abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq", 56, 1,
+		{0x84983e44, 0x1c3bd26e, 0xbaae4aa1, 0xf95129e5, 0xe54670f1}},
+	{"nist-896bit", "abcdefghbcdefghicdefghijdefghijkefghijklfghijklmghijklmnhijklmnoijklmnopjklmnopqklmnopqrlmnopqrsmnopqrstnopqrstu", 112, 1,
+		{0xa49b2446, 0xa02c645b, 0xf419f995, 0xb6709125, 0x3a04a259}},
+	{"million-a", "a", 1, 1000000,
+		{0x34aa973c, 0xd4c4daa4, 0xf61eeb2b, 0xdbad2731, 0x6534016f}},
+	{"fsoc", "FSOC23/24 is fun!", 17, 1,
+		{0xa617f4b3, 0xa108b6dd, 0x82bb8c4a, 0x16ab0b35, 0x2a32a0b9}},
+	{"fsoc-binary", "FSOC23/24\0is fun!", 17, 1,
+		{0xcb0ef6a0, 0x451a90fe, 0xa62b8e18, 0x32a1edf5, 0x863bc2f3}},
+	{"quick-brown-fox", "The quick brown fox jumps over the lazy dog", 43, 1,
+		{0x2fd4e1c6, 0x7a2d28fc, 0xed849ee1, 0xbb76e739, 0x1b93eb12}},
+};
+
+#define SELFTEST_NUM_OF_KATS	(sizeof(SELFTEST_kats) / sizeof(SELFTEST_kats[0]))
+
+//piece sizes of the streaming check, chosen to cross the 64-byte block border at every offset
+static const uint32_t SELFTEST_pieceLengths[] = {1, 3, 7, 13, 64, 65, 127, 200};
+
+#define SELFTEST_NUM_OF_PIECE_LENGTHS	(sizeof(SELFTEST_pieceLengths) / sizeof(SELFTEST_pieceLengths[0]))
+
+//shared, read-only input and expected results of the concurrency check
+static uint8_t SELFTEST_messagePool[SELFTEST_MAX_MESSAGE_LENGTH + SELFTEST_NUM_OF_MESSAGES];
+static uint32_t SELFTEST_expectedHash[SELFTEST_NUM_OF_MESSAGES][SHA1_NUM_OF_HASH_WORDS_PER_BLOCK];
+
+//number of failed checks
+static uint32_t SELFTEST_numOfFailures = 0;
+
+
+/*****************************************************************************/
+/* Local function prototypes ('static')                                      */
+/*****************************************************************************/
+
+static void SELFTEST_report(const char* checkName, const char* subName, boolean_t isCorrect);
+static boolean_t SELFTEST_isSameHash(const uint32_t* hash, const uint32_t* expectedHash);
+static uint32_t SELFTEST_random(uint32_t* randomState);
+static uint8_t* SELFTEST_buildMessage(const SELFTEST_kat_t* kat, uint64_t* length);
+static boolean_t SELFTEST_hashWithPacket(const uint8_t* data, uint64_t length, uint32_t* hash);
+static void SELFTEST_checkKats(void);
+static void SELFTEST_checkCompression(const char* name, SELFTEST_compress_t compress, boolean_t isInPlaceSafe);
+static void SELFTEST_getMessage(uint32_t messageIndex, const uint8_t** data, uint64_t* length);
+static void* SELFTEST_threadMain(void* argument);
+static void SELFTEST_checkConcurrency(void);
+static boolean_t SELFTEST_powReference(const SHA1_powJob_t* job, uint32_t* nonce, uint32_t* hash, uint32_t* numOfNoncesTried);
+static boolean_t SELFTEST_isSamePowResult(const SHA1_powJob_t* job);
+static void SELFTEST_checkProofOfWork(void);
+
+
+/*****************************************************************************/
+/* Function implementation - global ('extern') and local ('static')          */
+/*****************************************************************************/
+
+int main(void)
+{
+	printf("SHA-1 host self-test, sha_1() uses Compression Function %d, SHA-NI %s, multi-buffer lanes %u\n",
+			SHA1_CONFIG_COMPRESSION,
+			SHA1_niIsSupported() ? "supported" : "not supported",
+			(unsigned int)SHA1_mbGetNumOfLanes());
+
+	SELFTEST_checkKats();
+
+	//the original stage dispatch writes hash_ptr while it still reads prev_hash, the newer ones do not
+	SELFTEST_checkCompression("compress-unrolled", SHA1_compressUnrolled, TRUE);
+	SELFTEST_checkCompression("compress-ni-dispatch", SHA1_niCompressDispatch, TRUE);
+	SELFTEST_checkCompression("compress-custom-instr", SHA1_compressCustomInstr, TRUE);
+	SELFTEST_checkCompression("sha_1", sha_1, (SHA1_CONFIG_COMPRESSION != SHA1_COMPRESSION_STAGE_DISPATCH) ? TRUE : FALSE);
+	if(TRUE == SHA1_niIsSupported())
+	{
+		SELFTEST_checkCompression("compress-sha-ni", SHA1_niCompress, TRUE);
+	}
+
+	SELFTEST_checkConcurrency();
+	SELFTEST_checkProofOfWork();
+
+	printf("%s: %u check(s) failed\n", (SELFTEST_numOfFailures == 0) ? "PASS" : "FAIL",
+			(unsigned int)SELFTEST_numOfFailures);
+
+	return (SELFTEST_numOfFailures == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+/**
+ * \brief Prints the result of one check and counts the failures.
+ *
+ * \param const char* checkName : IN - name of the check
+ * \param const char* subName : IN - name of the input or the variant
+ * \param boolean_t isCorrect : IN - result of the check
+ */
+static void SELFTEST_report(const char* checkName, const char* subName, boolean_t isCorrect)
+{
+	printf("%s %s/%s\n", isCorrect ? "PASS" : "FAIL", checkName, subName);
+
+	if(FALSE == isCorrect)
+	{
+		SELFTEST_numOfFailures++;
+	}
+}
+
+/**
+ * \brief Compares two sets of 5 hash words.
+ *
+ * \param const uint32_t* hash : IN - the computed hash
+ * \param const uint32_t* expectedHash : IN - the correct/expected hash
+ * \return TRUE if all 5 hash words are equal, otherwise FALSE
+ */
+static boolean_t SELFTEST_isSameHash(const uint32_t* hash, const uint32_t* expectedHash)
+{
+	return (0 == memcmp(hash, expectedHash, SHA1_NUM_OF_HASH_WORDS_PER_BLOCK * sizeof(uint32_t))) ? TRUE : FALSE;
+}
+
+/**
+ * \brief xorshift32 pseudo-random generator, same as in main.c.
+ *
+ * \param uint32_t* randomState : IN/OUT - state of the generator, must not be 0
+ * \return the next pseudo-random number
+ */
+static uint32_t SELFTEST_random(uint32_t* randomState)
+{
+	*randomState ^= *randomState << 13;
+	*randomState ^= *randomState >> 17;
+	*randomState ^= *randomState << 5;
+
+	return *randomState;
+}
+
+/**
+ * \brief Builds the message of a known-answer test in a new buffer.
+ *
+ * \param const SELFTEST_kat_t* kat : IN - the known-answer test
+ * \param uint64_t* length : OUT - length of the message, in bytes
+ * \return the message, to be released with free()
+ */
+static uint8_t* SELFTEST_buildMessage(const SELFTEST_kat_t* kat, uint64_t* length)
+{
+	*length = (uint64_t)kat->m_patternLength * kat->m_numOfRepeats;
+
+	//one more byte for the null-termination that MSG_init() needs
+	uint8_t* data = (uint8_t*)malloc(*length + 1);
+
+	for(uint32_t repeatIndex = 0; repeatIndex < kat->m_numOfRepeats; repeatIndex++)
+	{
+		memcpy(&data[(uint64_t)repeatIndex * kat->m_patternLength], kat->m_pattern, kat->m_patternLength);
+	}
+	data[*length] = '\0';
+
+	return data;
+}
+
+/**
+ * \brief Hashes a message with the Message and SHA-1 Packet Objects, like main.c does.
+ *
+ * \param const uint8_t* data : IN - the message, a null-terminated ASCII string (MSG_init() copies it with strcpy())
+ * \param uint64_t length : IN - length of the message, in bytes
+ * \param uint32_t* hash : OUT - the 5 final hash words
+ * \return FALSE if the message is too long for MSG_init(), otherwise TRUE
+ */
+static boolean_t SELFTEST_hashWithPacket(const uint8_t* data, uint64_t length, uint32_t* hash)
+{
+	MSG_message_t message;
+	SHA1_packet_t packet;
+
+	if(length > 0xFFFFFFFFu)
+	{
+		return FALSE;
+	}
+
+	MSG_init(&message, (const char*)data, (uint32_t)length);
+	SHA1_init(&packet, &message);
+
+	SHA1_processPacket(&packet);
+
+	memcpy(hash, packet.m_512bit_block[packet.m_numOf512bitBlocks - 1].m_outputHash,
+			SHA1_NUM_OF_HASH_WORDS_PER_BLOCK * sizeof(uint32_t));
+
+	SHA1_freeMemory(&packet);
+	MSG_freeMemory(&message);
+
+	return TRUE;
+}
+
+/**
+ * \brief Known-answer tests with every API: Packet Object, SHA1_hashBuffer(), streaming context and multi-buffer engine.
+ */
+static void SELFTEST_checkKats(void)
+{
+	static const uint32_t numOfLanes[] = {1, 4, 8, 16};
+
+	uint32_t hash[SHA1_NUM_OF_HASH_WORDS_PER_BLOCK];
+	SHA1_mbJob_t jobs[SELFTEST_NUM_OF_KATS];
+	uint8_t* data[SELFTEST_NUM_OF_KATS];
+
+	for(uint32_t katIndex = 0; katIndex < SELFTEST_NUM_OF_KATS; katIndex++)
+	{
+		const SELFTEST_kat_t* kat = &SELFTEST_kats[katIndex];
+		uint64_t length;
+
+		data[katIndex] = SELFTEST_buildMessage(kat, &length);
+		jobs[katIndex].m_data = data[katIndex];
+		jobs[katIndex].m_length = length;
+
+		//Packet Object, only knows ASCII strings
+		if(strlen((const char*)data[katIndex]) == length)
+		{
+			SELFTEST_report("packet", kat->m_name,
+					SELFTEST_hashWithPacket(data[katIndex], length, hash) && SELFTEST_isSameHash(hash, kat->m_hash));
+		}
+
+		//zero-copy, aligned (malloc) and unaligned address
+		SHA1_hashBuffer(hash, data[katIndex], length);
+		SELFTEST_report("hash-buffer", kat->m_name, SELFTEST_isSameHash(hash, kat->m_hash));
+
+		uint8_t* unalignedData = (uint8_t*)malloc(length + 1);
+		memcpy(unalignedData + 1, data[katIndex], length);
+		SHA1_hashBuffer(hash, unalignedData + 1, length);
+		SELFTEST_report("hash-buffer-unaligned", kat->m_name, SELFTEST_isSameHash(hash, kat->m_hash));
+		free(unalignedData);
+
+		//streaming context, fed in pieces of every length in SELFTEST_pieceLengths
+		boolean_t isCorrect = TRUE;
+		for(uint32_t pieceIndex = 0; pieceIndex < SELFTEST_NUM_OF_PIECE_LENGTHS; pieceIndex++)
+		{
+			SHA1_ctx_t ctx;
+			uint64_t offset = 0;
+
+			SHA1_ctxInit(&ctx);
+			while(offset < length)
+			{
+				uint64_t pieceLength = SELFTEST_pieceLengths[pieceIndex];
+				if(pieceLength > (length - offset))
+				{
+					pieceLength = length - offset;
+				}
+
+				SHA1_ctxUpdate(&ctx, &data[katIndex][offset], pieceLength);
+				offset += pieceLength;
+			}
+			SHA1_ctxFinal(&ctx, hash);
+
+			if(FALSE == SELFTEST_isSameHash(hash, kat->m_hash))
+			{
+				isCorrect = FALSE;
+			}
+		}
+		SELFTEST_report("ctx-pieces", kat->m_name, isCorrect);
+	}
+
+	//multi-buffer engine, all messages at once with every kernel (the ones the CPU lacks fall back to a narrower one)
+	for(uint32_t lanesIndex = 0; lanesIndex < (sizeof(numOfLanes) / sizeof(numOfLanes[0])); lanesIndex++)
+	{
+		char subName[16];
+		boolean_t isCorrect = TRUE;
+
+		SHA1_mbHashJobs(jobs, SELFTEST_NUM_OF_KATS, numOfLanes[lanesIndex]);
+
+		for(uint32_t katIndex = 0; katIndex < SELFTEST_NUM_OF_KATS; katIndex++)
+		{
+			if(FALSE == SELFTEST_isSameHash(jobs[katIndex].m_hash, SELFTEST_kats[katIndex].m_hash))
+			{
+				isCorrect = FALSE;
+			}
+		}
+
+		snprintf(subName, sizeof(subName), "lanes-%u", (unsigned int)numOfLanes[lanesIndex]);
+		SELFTEST_report("multi-buffer", subName, isCorrect);
+	}
+
+	for(uint32_t katIndex = 0; katIndex < SELFTEST_NUM_OF_KATS; katIndex++)
+	{
+		free(data[katIndex]);
+	}
+}
+
+/**
+ * \brief Checks a Compression Function against SHA1_compressStageDispatch() on pseudo-random blocks,
+ * 		  with separate and (if it supports it) with the same input/output hash array.
+ *
+ * \param const char* name : IN - name printed in the PASS/FAIL line
+ * \param SELFTEST_compress_t compress : IN - the Compression Function
+ * \param boolean_t isInPlaceSafe : IN - TRUE if hash_ptr may point to prev_hash
+ */
+static void SELFTEST_checkCompression(const char* name, SELFTEST_compress_t compress, boolean_t isInPlaceSafe)
+{
+	uint32_t randomState = 0x2545F491;
+
+	uint32_t word[SHA1_TOTAL_WORDS_PER_BLOCK];
+	uint32_t prevHash[SHA1_NUM_OF_HASH_WORDS_PER_BLOCK];
+	uint32_t referenceHash[SHA1_NUM_OF_HASH_WORDS_PER_BLOCK];
+	uint32_t hash[SHA1_NUM_OF_HASH_WORDS_PER_BLOCK];
+	boolean_t isCorrect = TRUE;
+	boolean_t isInPlaceCorrect = TRUE;
+
+	for(uint32_t blockIndex = 0; blockIndex < SELFTEST_NUM_OF_RANDOM_BLOCKS; blockIndex++)
+	{
+		for(uint8_t wordIndex = 0; wordIndex < SHA1_TOTAL_WORDS_PER_BLOCK; wordIndex++)
+		{
+			word[wordIndex] = SELFTEST_random(&randomState);
+		}
+
+		for(uint8_t hashIndex = SHA1_HASH_A; hashIndex < SHA1_NUM_OF_HASH_WORDS_PER_BLOCK; hashIndex++)
+		{
+			prevHash[hashIndex] = SELFTEST_random(&randomState);
+		}
+
+		SHA1_compressStageDispatch(referenceHash, word, prevHash);
+
+		compress(hash, word, prevHash);
+		if(FALSE == SELFTEST_isSameHash(hash, referenceHash))
+		{
+			isCorrect = FALSE;
+		}
+
+		//hash_ptr == prev_hash
+		if(TRUE == isInPlaceSafe)
+		{
+			compress(prevHash, word, prevHash);
+			if(FALSE == SELFTEST_isSameHash(prevHash, referenceHash))
+			{
+				isInPlaceCorrect = FALSE;
+			}
+		}
+	}
+
+	SELFTEST_report(name, "random-blocks", isCorrect);
+	if(TRUE == isInPlaceSafe)
+	{
+		SELFTEST_report(name, "in-place", isInPlaceCorrect);
+	}
+}
+
+/**
+ * \brief Message of the concurrency check: a slice of SELFTEST_messagePool.
+ *
+ * \param uint32_t messageIndex : IN - index of the message
+ * \param const uint8_t** data : OUT - the message
+ * \param uint64_t* length : OUT - length of the message, in bytes
+ */
+static void SELFTEST_getMessage(uint32_t messageIndex, const uint8_t** data, uint64_t* length)
+{
+	*data = &SELFTEST_messagePool[messageIndex];
+	*length = (messageIndex * 2654435761u) % (SELFTEST_MAX_MESSAGE_LENGTH + 1);
+}
+
+/**
+ * \brief Thread of the concurrency check: hashes all messages, starting at a different one in every thread.
+ *
+ * \param void* argument : IN/OUT - SELFTEST_thread_t of the thread
+ * \return NULL
+ */
+static void* SELFTEST_threadMain(void* argument)
+{
+	SELFTEST_thread_t* thread = (SELFTEST_thread_t*)argument;
+	uint32_t hash[SHA1_NUM_OF_HASH_WORDS_PER_BLOCK];
+
+	thread->m_isCorrect = TRUE;
+
+	for(uint32_t i = 0; i < SELFTEST_NUM_OF_MESSAGES; i++)
+	{
+		uint32_t messageIndex = (i + (thread->m_threadIndex * (SELFTEST_NUM_OF_MESSAGES / SELFTEST_NUM_OF_THREADS))) % SELFTEST_NUM_OF_MESSAGES;
+		const uint8_t* data;
+		uint64_t length;
+		SHA1_ctx_t ctx;
+
+		SELFTEST_getMessage(messageIndex, &data, &length);
+
+		//every other message goes through the streaming context in two pieces
+		if((messageIndex % 2) == 0)
+		{
+			SHA1_hashBuffer(hash, data, length);
+		}
+		else
+		{
+			SHA1_ctxInit(&ctx);
+			SHA1_ctxUpdate(&ctx, data, length / 2);
+			SHA1_ctxUpdate(&ctx, &data[length / 2], length - (length / 2));
+			SHA1_ctxFinal(&ctx, hash);
+		}
+
+		if(FALSE == SELFTEST_isSameHash(hash, SELFTEST_expectedHash[messageIndex]))
+		{
+			thread->m_isCorrect = FALSE;
+		}
+	}
+
+	return NULL;
+}
+
+/**
+ * \brief Hashes the same messages in SELFTEST_NUM_OF_THREADS threads at the same time and compares them
+ * 		  with the single-threaded results, the library must not keep any shared state.
+ */
+static void SELFTEST_checkConcurrency(void)
+{
+	uint32_t randomState = 0x6B8B4567;
+	pthread_t threadId[SELFTEST_NUM_OF_THREADS];
+	SELFTEST_thread_t thread[SELFTEST_NUM_OF_THREADS];
+	boolean_t isCorrect = TRUE;
+
+	for(uint32_t i = 0; i < sizeof(SELFTEST_messagePool); i++)
+	{
+		SELFTEST_messagePool[i] = (uint8_t)SELFTEST_random(&randomState);
+	}
+
+	//single-threaded reference, SHA1_hashBuffer() itself is checked by SELFTEST_checkKats()
+	for(uint32_t messageIndex = 0; messageIndex < SELFTEST_NUM_OF_MESSAGES; messageIndex++)
+	{
+		const uint8_t* data;
+		uint64_t length;
+
+		SELFTEST_getMessage(messageIndex, &data, &length);
+		SHA1_hashBuffer(SELFTEST_expectedHash[messageIndex], data, length);
+	}
+
+	for(uint32_t threadIndex = 0; threadIndex < SELFTEST_NUM_OF_THREADS; threadIndex++)
+	{
+		thread[threadIndex].m_threadIndex = threadIndex;
+		if(0 != pthread_create(&threadId[threadIndex], NULL, SELFTEST_threadMain, &thread[threadIndex]))
+		{
+			SELFTEST_report("concurrency", "pthread_create", FALSE);
+			return;
+		}
+	}
+
+	for(uint32_t threadIndex = 0; threadIndex < SELFTEST_NUM_OF_THREADS; threadIndex++)
+	{
+		pthread_join(threadId[threadIndex], NULL);
+		if(FALSE == thread[threadIndex].m_isCorrect)
+		{
+			isCorrect = FALSE;
+		}
+	}
+
+	SELFTEST_report("concurrency", "threads", isCorrect);
+}
+
+/**
+ * \brief The result of a proof-of-work search the slow way: the whole stamp of every nonce with SHA1_hashBuffer().
+ *
+ * \param const SHA1_powJob_t* job : IN - the search, only the IN members are used
+ * \param uint32_t* nonce : OUT - the first nonce that meets the target
+ * \param uint32_t* hash : OUT - its 5 hash words
+ * \param uint32_t* numOfNoncesTried : OUT - up to and including nonce, or all of the range
+ * \return TRUE if a nonce of the range meets the target
+ */
+static boolean_t SELFTEST_powReference(const SHA1_powJob_t* job, uint32_t* nonce, uint32_t* hash, uint32_t* numOfNoncesTried)
+{
+	uint8_t stamp[SELFTEST_POW_MAX_PREFIX_LENGTH + SHA1_POW_NONCE_LENGTH];
+
+	memcpy(stamp, job->m_prefix, job->m_prefixLength);
+
+	for(uint32_t offset = 0; offset < job->m_numOfNonces; offset++)
+	{
+		boolean_t isMet = TRUE;
+
+		SHA1_powFormatNonce((char*)&stamp[job->m_prefixLength], job->m_firstNonce + offset);
+		SHA1_hashBuffer(hash, stamp, job->m_prefixLength + SHA1_POW_NONCE_LENGTH);
+
+		for(uint8_t hashIndex = 0; hashIndex < SHA1_NUM_OF_HASH_WORDS_PER_BLOCK; hashIndex++)
+		{
+			if(0 != (hash[hashIndex] & job->m_targetMask[hashIndex]))
+			{
+				isMet = FALSE;
+			}
+		}
+
+		if(TRUE == isMet)
+		{
+			*nonce = job->m_firstNonce + offset;
+			*numOfNoncesTried = offset + 1;
+			return TRUE;
+		}
+	}
+
+	*numOfNoncesTried = job->m_numOfNonces;
+
+	return FALSE;
+}
+
+/**
+ * \brief Compares the OUT members of a proof-of-work search with SELFTEST_powReference().
+ *
+ * \param const SHA1_powJob_t* job : IN - the search after SHA1_powSearch() or SHA1_powSearchParallel()
+ * \return TRUE if both found the same nonce with the same hash after the same number of nonces, or both none
+ */
+static boolean_t SELFTEST_isSamePowResult(const SHA1_powJob_t* job)
+{
+	uint32_t nonce = 0;
+	uint32_t hash[SHA1_NUM_OF_HASH_WORDS_PER_BLOCK];
+	uint32_t numOfNoncesTried;
+	boolean_t isFound = SELFTEST_powReference(job, &nonce, hash, &numOfNoncesTried);
+
+	if((isFound != job->m_isFound) || (numOfNoncesTried != job->m_numOfNoncesTried))
+	{
+		return FALSE;
+	}
+
+	return ((FALSE == isFound) || ((nonce == job->m_nonce) && (TRUE == SELFTEST_isSameHash(hash, job->m_hash)))) ? TRUE : FALSE;
+}
+
+/**
+ * \brief Proof-of-work search: the target mask, SHA1_powSearch() and SHA1_powSearchParallel() against a search with
+ * 		  SHA1_hashBuffer() on the whole stamp of every nonce.
+ *
+ * Prefixes of every length up to SELFTEST_POW_MAX_PREFIX_LENGTH, so the nonce is at every offset of the tail
+ * block, across the block border and in front of a second tail block. A range at the end of the nonces wraps
+ * around to 0, a range without a hit must report all of its nonces.
+ */
+static void SELFTEST_checkProofOfWork(void)
+{
+	static const uint32_t expectedMask20[SHA1_NUM_OF_HASH_WORDS_PER_BLOCK] = {0xFFFFF000u, 0, 0, 0, 0};
+	static const uint32_t expectedMask40[SHA1_NUM_OF_HASH_WORDS_PER_BLOCK] = {0xFFFFFFFFu, 0xFF000000u, 0, 0, 0};
+	uint32_t randomState = 0x2545F491;
+	uint8_t prefix[SELFTEST_POW_MAX_PREFIX_LENGTH];
+	SHA1_powJob_t job;
+	uint32_t targetMask[SHA1_NUM_OF_HASH_WORDS_PER_BLOCK];
+	boolean_t isSearchCorrect = TRUE;
+	boolean_t isParallelCorrect = TRUE;
+	boolean_t isCorrect;
+
+	SHA1_powTargetMask(targetMask, 20);
+	isCorrect = SELFTEST_isSameHash(targetMask, expectedMask20);
+	SHA1_powTargetMask(targetMask, 40);
+	isCorrect = (isCorrect && SELFTEST_isSameHash(targetMask, expectedMask40)) ? TRUE : FALSE;
+	SHA1_powTargetMask(targetMask, 160);
+	isCorrect = (isCorrect && (0xFFFFFFFFu == (targetMask[SHA1_HASH_A] & targetMask[SHA1_HASH_E]))) ? TRUE : FALSE;
+	SELFTEST_report("proof-of-work", "target-mask", isCorrect);
+
+	//a hashcash-like header in front of random bytes
+	for(uint32_t i = 0; i < SELFTEST_POW_MAX_PREFIX_LENGTH; i++)
+	{
+		prefix[i] = (uint8_t)SELFTEST_random(&randomState);
+	}
+	memcpy(prefix, "1:8:261017:fsoc@h-da.de::", 25);
+
+	job.m_prefix = prefix;
+	SHA1_powTargetMask(job.m_targetMask, SELFTEST_POW_ZERO_BITS);
+
+	for(uint32_t prefixLength = 0; prefixLength <= SELFTEST_POW_MAX_PREFIX_LENGTH; prefixLength++)
+	{
+		job.m_prefixLength = prefixLength;
+		job.m_firstNonce = SELFTEST_random(&randomState);
+		job.m_numOfNonces = SELFTEST_POW_NUM_OF_NONCES;
+
+		SHA1_powSearch(&job);
+		if(FALSE == SELFTEST_isSamePowResult(&job))
+		{
+			isSearchCorrect = FALSE;
+		}
+
+		SHA1_powSearchParallel(&job, 1 + (prefixLength % 4));
+		if(FALSE == SELFTEST_isSamePowResult(&job))
+		{
+			isParallelCorrect = FALSE;
+		}
+	}
+	SELFTEST_report("proof-of-work", "search", isSearchCorrect);
+	SELFTEST_report("proof-of-work", "search-parallel", isParallelCorrect);
+
+	//the range wraps around from 0xFFFFFFFF to 0
+	job.m_prefixLength = 60;
+	job.m_firstNonce = 0xFFFFFF00u;
+	job.m_numOfNonces = SELFTEST_POW_NUM_OF_NONCES;
+	SHA1_powSearchParallel(&job, 3);
+	SELFTEST_report("proof-of-work", "nonce-wrap", SELFTEST_isSamePowResult(&job));
+
+	//many pieces, the threads find hits in several of them at the same time and the lowest must win
+	isCorrect = TRUE;
+	SHA1_powTargetMask(job.m_targetMask, SELFTEST_POW_LONG_ZERO_BITS);
+	for(uint32_t prefixLength = 25; prefixLength <= 121; prefixLength += 32)
+	{
+		job.m_prefixLength = prefixLength;
+		job.m_firstNonce = SELFTEST_random(&randomState);
+		job.m_numOfNonces = SELFTEST_POW_LONG_NUM_OF_NONCES;
+		SHA1_powSearchParallel(&job, SELFTEST_NUM_OF_THREADS);
+		if(FALSE == SELFTEST_isSamePowResult(&job))
+		{
+			isCorrect = FALSE;
+		}
+	}
+	SELFTEST_report("proof-of-work", "many-pieces", isCorrect);
+
+	//no hit: every nonce of the range is tried
+	SHA1_powTargetMask(job.m_targetMask, 160);
+	job.m_numOfNonces = 10000;
+	SHA1_powSearchParallel(&job, SELFTEST_NUM_OF_THREADS);
+	isCorrect = ((FALSE == job.m_isFound) && (10000 == job.m_numOfNoncesTried)) ? TRUE : FALSE;
+	SHA1_powSearch(&job);
+	isCorrect = (isCorrect && (FALSE == job.m_isFound) && (10000 == job.m_numOfNoncesTried)) ? TRUE : FALSE;
+	SELFTEST_report("proof-of-work", "not-found", isCorrect);
+}